@@ -0,0 +1,177 @@
+#include "alloc_tracking.h"
+
+#ifdef TIME_TRACKER_ALLOC_TRACKING
+#include "windows_includes.h"
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace time_tracker {
+    namespace alloc_tracking {
+        namespace {
+            struct operation_counters {
+                std::atomic<const char*> name;
+                std::atomic<std::size_t> allocations;
+                std::atomic<std::size_t> bytes;
+                std::atomic<std::size_t> live_bytes;
+                std::atomic<std::size_t> peak_bytes;
+            };
+
+            // static storage is zero-initialized, so the counters work before main
+            operation_counters g_operations[MAX_OPERATIONS];
+
+            thread_local std::size_t t_operation = 0;
+            thread_local std::size_t t_allocations = 0;
+
+            // keeps the size and owning operation in front of every block
+            struct alignas(16) block_header {
+                std::size_t size;
+                std::size_t operation;
+            };
+
+            std::size_t find_operation(const char* name) {
+                for (std::size_t i = 1; i < MAX_OPERATIONS; ++i) {
+                    const char* current = g_operations[i].name.load(std::memory_order_acquire);
+                    if (!current) {
+                        if (g_operations[i].name.compare_exchange_strong(current, name)) {
+                            return i;
+                        }
+                    }
+                    if (current == name || std::strcmp(current, name) == 0) {
+                        return i;
+                    }
+                }
+                return 0;  // table full, counted as unscoped
+            }
+
+            void* allocate(std::size_t size) {
+                auto header = static_cast<block_header*>(std::malloc(sizeof(block_header) + size));
+                if (!header) return nullptr;
+
+                header->size = size;
+                header->operation = t_operation;
+                ++t_allocations;
+
+                auto& counters = g_operations[t_operation];
+                counters.allocations.fetch_add(1, std::memory_order_relaxed);
+                counters.bytes.fetch_add(size, std::memory_order_relaxed);
+
+                std::size_t live = counters.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+                std::size_t peak = counters.peak_bytes.load(std::memory_order_relaxed);
+                while (live > peak && !counters.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+                }
+
+                return header + 1;
+            }
+
+            void release(void* block) {
+                if (!block) return;
+
+                auto header = static_cast<block_header*>(block) - 1;
+                g_operations[header->operation].live_bytes.fetch_sub(header->size, std::memory_order_relaxed);
+                std::free(header);
+            }
+
+            void* allocate_or_throw(std::size_t size) {
+                void* block = allocate(size ? size : 1);
+                if (!block) throw std::bad_alloc();
+                return block;
+            }
+        }
+
+        scope::scope(const char* name, bool require_zero_allocations)
+            : operation_(find_operation(name))
+            , previous_operation_(t_operation)
+            , allocations_at_entry_(t_allocations)
+            , require_zero_(require_zero_allocations) {
+            t_operation = operation_;
+        }
+
+        scope::~scope() {
+            t_operation = previous_operation_;
+
+            if (require_zero_ && allocations() > 0) {
+                char message[160];
+                std::snprintf(message, sizeof(message), "alloc_tracking: %zu allocation(s) in zero-allocation scope \"%s\"\n",
+                    allocations(), g_operations[operation_].name.load());
+                OutputDebugStringA(message);
+                assert(!"allocation in a zero-allocation scope");
+            }
+        }
+
+        std::size_t scope::allocations() const {
+            return t_allocations - allocations_at_entry_;
+        }
+
+        std::size_t get_stats(operation_stats* stats, std::size_t max_count) {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < MAX_OPERATIONS && count < max_count; ++i) {
+                const char* name = g_operations[i].name.load();
+                if (i > 0 && !name) break;
+
+                stats[count].name = name ? name : "(no scope)";
+                stats[count].allocations = g_operations[i].allocations.load();
+                stats[count].bytes = g_operations[i].bytes.load();
+                stats[count].peak_bytes = g_operations[i].peak_bytes.load();
+                ++count;
+            }
+            return count;
+        }
+
+        void write_report(std::ostream& out) {
+            operation_stats stats[MAX_OPERATIONS];
+            std::size_t count = get_stats(stats, MAX_OPERATIONS);
+
+            out << "operation - allocations - bytes - peak bytes\n";
+            for (std::size_t i = 0; i < count; ++i) {
+                out << stats[i].name << " - " << stats[i].allocations << " - "
+                    << stats[i].bytes << " - " << stats[i].peak_bytes << "\n";
+            }
+        }
+    }
+}
+
+// counting replacements of the global allocation functions
+void* operator new(std::size_t size) {
+    return time_tracker::alloc_tracking::allocate_or_throw(size);
+}
+
+void* operator new[](std::size_t size) {
+    return time_tracker::alloc_tracking::allocate_or_throw(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return time_tracker::alloc_tracking::allocate(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return time_tracker::alloc_tracking::allocate(size ? size : 1);
+}
+
+void operator delete(void* block) noexcept {
+    time_tracker::alloc_tracking::release(block);
+}
+
+void operator delete[](void* block) noexcept {
+    time_tracker::alloc_tracking::release(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    time_tracker::alloc_tracking::release(block);
+}
+
+void operator delete[](void* block, std::size_t) noexcept {
+    time_tracker::alloc_tracking::release(block);
+}
+
+void operator delete(void* block, const std::nothrow_t&) noexcept {
+    time_tracker::alloc_tracking::release(block);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept {
+    time_tracker::alloc_tracking::release(block);
+}
+#endif
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+
+// opt-in allocation accounting. define TIME_TRACKER_ALLOC_TRACKING in the project's
+// preprocessor definitions to replace the global operator new/delete with counting
+// versions. without it the scope macros compile to nothing.
+//
+//   ALLOC_SCOPE("weekly hours update");     // attribute allocations to an operation
+//   ZERO_ALLOC_SCOPE("status update");      // also assert that nothing is allocated
+
+namespace time_tracker {
+    namespace alloc_tracking {
+        struct operation_stats {
+            const char* name;
+            std::size_t allocations;
+            std::size_t bytes;          // total bytes allocated
+            std::size_t peak_bytes;     // highest number of live bytes
+        };
+
+        // attributes allocations on this thread to a named operation until destroyed.
+        // names must be string literals, at most MAX_OPERATIONS distinct names are tracked.
+        class scope {
+        private:
+            std::size_t operation_;
+            std::size_t previous_operation_;
+            std::size_t allocations_at_entry_;
+            bool require_zero_;
+
+        public:
+            explicit scope(const char* name, bool require_zero_allocations = false);
+            ~scope();
+
+            scope(const scope&) = delete;
+            scope& operator=(const scope&) = delete;
+
+            // allocations on this thread since the scope was entered, nested scopes included
+            std::size_t allocations() const;
+        };
+
+        constexpr std::size_t MAX_OPERATIONS = 32;
+
+        // counters of every operation seen so far, the first entry collects
+        // allocations made outside of any scope
+        std::size_t get_stats(operation_stats* stats, std::size_t max_count);
+        void write_report(std::ostream& out);
+    }
+}
+
+#ifdef TIME_TRACKER_ALLOC_TRACKING
+#define ALLOC_SCOPE(name) ::time_tracker::alloc_tracking::scope alloc_scope_(name)
+#define ZERO_ALLOC_SCOPE(name) ::time_tracker::alloc_tracking::scope alloc_scope_(name, true)
+#else
+#define ALLOC_SCOPE(name)
+#define ZERO_ALLOC_SCOPE(name)
+#endif
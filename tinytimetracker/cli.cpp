@@ -0,0 +1,296 @@
+#include "cli.h"
+#include "log_merge.h"
+#include "work_calendar.h"
+#include "log_pager.h"
+#include "log_verifier.h"
+#include "session_journal.h"
+#include "logger.h"
+#include "alloc_tracking.h"
+#include "menu_info.h"
+#include "time_utils.h"
+#include "config.h"
+#include <cstdio>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace time_tracker {
+    namespace cli {
+        namespace {
+            std::vector<std::string> get_arguments() {
+                std::vector<std::string> arguments;
+
+                int argc = 0;
+                LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+                if (!argv) return arguments;
+
+                // skip the executable path, paths are used with the narrow file apis
+                for (int i = 1; i < argc; ++i) {
+                    int size = WideCharToMultiByte(CP_ACP, 0, argv[i], -1, nullptr, 0, nullptr, nullptr);
+                    std::string argument(size > 0 ? size - 1 : 0, '\0');
+                    if (size > 1) {
+                        WideCharToMultiByte(CP_ACP, 0, argv[i], -1, &argument[0], size, nullptr, nullptr);
+                    }
+                    arguments.push_back(argument);
+                }
+
+                LocalFree(argv);
+                return arguments;
+            }
+
+            // the app is a windows subsystem binary, so borrow the console it was started from
+            void attach_console() {
+                if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+                    std::freopen("CONOUT$", "w", stdout);
+                    std::freopen("CONOUT$", "w", stderr);
+                }
+            }
+
+            int merge_logs(const std::vector<std::string>& arguments) {
+                if (arguments.size() < 3) {
+                    std::cerr << "usage: tinytimetracker --merge-logs <output> <input>...\n";
+                    return 2;
+                }
+
+                std::vector<std::string> inputs(arguments.begin() + 2, arguments.end());
+                log_merge::merge_stats stats;
+
+                if (!log_merge::merge_logs(inputs, arguments[1], stats)) {
+                    std::cerr << "merge failed: could not read an input or write " << arguments[1] << "\n";
+                    return 1;
+                }
+
+                std::cout << "merged " << inputs.size() << " logs into " << arguments[1] << "\n"
+                    << "  lines read:         " << stats.lines_read << "\n"
+                    << "  lines written:      " << stats.lines_written << "\n"
+                    << "  duplicates dropped: " << stats.duplicates_dropped << "\n"
+                    << "  overlaps resolved:  " << stats.overlaps_resolved << "\n"
+                    << "  malformed lines:    " << stats.malformed_lines << "\n"
+                    << "  unclosed sessions:  " << stats.unclosed_sessions << "\n";
+                return 0;
+            }
+
+            int overtime_balance(const std::vector<std::string>& arguments) {
+                std::string weekly_log = arguments.size() > 1 ? arguments[1] : config::WEEKLY_LOG_FILE;
+                std::string calendar_file = arguments.size() > 2 ? arguments[2] : config::CALENDAR_FILE;
+
+                work_calendar calendar(config::CALENDAR_FIRST_YEAR, config::CALENDAR_LAST_YEAR);
+                calendar.load(calendar_file);
+
+                auto balance = compute_overtime_balance(calendar, weekly_log);
+                std::cout << "worked:   " << time_utils::format_duration(balance.worked) << "\n"
+                    << "expected: " << time_utils::format_duration(balance.expected) << "\n"
+                    << "balance:  " << time_utils::format_balance(balance.balance()) << "\n";
+                return 0;
+            }
+
+            int view_log(const std::vector<std::string>& arguments) {
+                if (arguments.size() < 2) {
+                    std::cerr << "usage: tinytimetracker --view-log <log> [lines] [YYYY-MM-DD]\n";
+                    return 2;
+                }
+
+                size_t count = config::LOG_VIEWER_PAGE_LINES;
+                if (arguments.size() > 2) {
+                    count = std::strtoul(arguments[2].c_str(), nullptr, 10);
+                }
+
+                // entries from the given day on need the index, the latest are read from the end
+                log_pager pager(arguments[1], true);
+                std::vector<std::string> lines;
+                int day = 0;
+                bool from_day = arguments.size() > 3 && work_calendar::parse_date(arguments[3], day);
+                if (from_day) {
+                    pager.refresh();
+                    lines = pager.read_lines(pager.find_day(day), count);
+                }
+                else {
+                    lines = pager.read_latest(count);
+                }
+
+                if (from_day ? pager.line_count() == 0 : lines.empty()) {
+                    std::cerr << "no entries in " << arguments[1] << "\n";
+                    return 1;
+                }
+
+                for (const auto& line : lines) {
+                    std::cout << line << "\n";
+                }
+                return 0;
+            }
+
+            int dump_session_journal(const std::vector<std::string>& arguments) {
+                std::string journal_path = arguments.size() > 1 ? arguments[1] : config::SESSION_JOURNAL_FILE;
+
+                session_journal journal;
+                if (!journal.open_read_only(journal_path)) {
+                    std::cerr << "could not read the session journal " << journal_path << "\n";
+                    return 1;
+                }
+
+                // to a file that --merge-logs and --view-log can read, or to the console
+                if (arguments.size() > 2) {
+                    std::ofstream out(arguments[2]);
+                    journal.dump(out);
+                    out.close();
+                    if (out.fail()) {
+                        std::cerr << "could not write " << arguments[2] << "\n";
+                        return 1;
+                    }
+                }
+                else {
+                    journal.dump(std::cout);
+                }
+                return 0;
+            }
+
+            int verify_logs(const std::vector<std::string>& arguments) {
+                std::vector<std::string> paths;
+                std::string repair_plan_path;
+                for (size_t i = 1; i < arguments.size(); ++i) {
+                    if (arguments[i] == "--repair-plan" && i + 1 < arguments.size()) {
+                        repair_plan_path = arguments[++i];
+                    }
+                    else {
+                        paths.push_back(arguments[i]);
+                    }
+                }
+
+                if (paths.size() > 2 || (arguments.size() > 1 && arguments.back() == "--repair-plan")) {
+                    std::cerr << "usage: tinytimetracker --verify-logs [time_log [weekly_log]] [--repair-plan <file>]\n";
+                    return 2;
+                }
+
+                // the weekly log is only checked by default for the tracker's own time log
+                std::string time_log = paths.empty() ? config::TIME_LOG_FILE : paths[0];
+                std::string weekly_log = paths.empty() ? config::WEEKLY_LOG_FILE : (paths.size() > 1 ? paths[1] : "");
+
+                auto start = std::chrono::steady_clock::now();
+                log_verifier::verify_result result;
+                if (!log_verifier::verify_logs(time_log, weekly_log, result)) {
+                    std::cerr << "could not read " << time_log << "\n";
+                    return 1;
+                }
+                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+                log_verifier::write_issues(result, std::cout);
+                log_verifier::write_notes(result, std::cout);
+                std::cout << "verified " << result.lines_scanned << " lines (" << result.bytes_scanned << " bytes) in "
+                    << result.chunks << " chunks on " << result.threads << " threads in " << elapsed.count() << " ms\n"
+                    << "  issues found: " << result.issues.size() << "\n";
+
+                if (!repair_plan_path.empty()) {
+                    std::ofstream plan(repair_plan_path);
+                    if (!plan.is_open()) {
+                        std::cerr << "could not write " << repair_plan_path << "\n";
+                        return 1;
+                    }
+                    log_verifier::write_repair_plan(result, plan);
+                    std::cout << "  repair plan:  " << repair_plan_path << " (" << result.repairs.size() << " edits)\n";
+                }
+
+                return result.issues.empty() ? 0 : 1;
+            }
+
+#ifdef TIME_TRACKER_ALLOC_TRACKING
+            // runs one hot path inside a counting scope, nested scopes included
+            template <typename operation>
+            bool runs_without_allocating(const char* name, operation run) {
+                std::size_t allocations = 0;
+                {
+                    alloc_tracking::scope tracked(name);
+                    run();
+                    allocations = tracked.allocations();
+                }
+
+                std::cout << "  " << name << ": " << allocations << " allocations\n";
+                return allocations == 0;
+            }
+
+            // the paths the tray app takes every second or on every clock event
+            int self_test_alloc() {
+                // set up outside the checks, logger and calendar allocate when created
+                logger scratch(config::ALLOC_SELF_TEST_LOG, config::ALLOC_SELF_TEST_LOG, config::ALLOC_SELF_TEST_LOG);
+                work_calendar calendar(config::CALENDAR_FIRST_YEAR, config::CALENDAR_LAST_YEAR);
+                auto clock_in_time = std::chrono::system_clock::now() - std::chrono::hours(5);
+
+                bool passed = true;
+
+                // the tray's per-second status update, in each state it can be in
+                auto now = std::chrono::system_clock::now();
+                const tracker_status states[] = {
+                    { work_state::clocked_out, now, now, false, false },
+                    { work_state::clocked_in, clock_in_time, now, false, false },
+                    { work_state::on_break, clock_in_time, now - std::chrono::minutes(10), true, false },
+                    { work_state::clocked_in, now - std::chrono::hours(10), now, true, true }
+                };
+                passed &= runs_without_allocating("status update", [&]() {
+                    for (const auto& status : states) {
+                        refresh_menu_info(status, calendar);
+                    }
+                });
+
+                passed &= runs_without_allocating("time entry", []() {
+                    time_entry entry("CLOCK IN", true);
+                    (void)entry;
+                });
+
+                passed &= runs_without_allocating("log append", [&]() {
+                    scratch.log_time_entry("CLOCK IN");
+                    scratch.log_time_entry("BREAK START", true);
+                    scratch.log_session_event("SESSION LOCK");
+                });
+
+                DeleteFileA(config::ALLOC_SELF_TEST_LOG);
+
+                std::cout << (passed ? "allocation self test passed\n" : "allocation self test failed\n");
+                return passed ? 0 : 1;
+            }
+#endif
+        }
+
+        bool run(int& exit_code) {
+            std::vector<std::string> arguments = get_arguments();
+            if (arguments.empty()) return false;
+
+            const std::string& mode = arguments[0];
+            if (mode == "--merge-logs") {
+                attach_console();
+                exit_code = merge_logs(arguments);
+                return true;
+            }
+            if (mode == "--view-log") {
+                attach_console();
+                exit_code = view_log(arguments);
+                return true;
+            }
+            if (mode == "--dump-session-journal") {
+                attach_console();
+                exit_code = dump_session_journal(arguments);
+                return true;
+            }
+            if (mode == "--verify-logs") {
+                attach_console();
+                exit_code = verify_logs(arguments);
+                return true;
+            }
+            if (mode == "--overtime-balance") {
+                attach_console();
+                exit_code = overtime_balance(arguments);
+                return true;
+            }
+#ifdef TIME_TRACKER_ALLOC_TRACKING
+            if (mode == "--self-test-alloc") {
+                attach_console();
+                exit_code = self_test_alloc();
+                return true;
+            }
+#endif
+
+            return false;
+        }
+    }
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include "types.h"
+
+namespace time_tracker {
+    namespace cli {
+        // run a command line tool mode (e.g. --merge-logs) if one was requested.
+        // returns false for a normal start of the tray application.
+        bool run(int& exit_code);
+    }
+}
@@ -21,6 +21,38 @@ namespace time_tracker {
         constexpr char WEEKLY_LOG_FILE[] = "weekly_hours.txt";
         constexpr char SESSION_LOG_FILE[] = "session_log.txt";
 
+        // session journal (optional bounded ring buffer used instead of the append-only
+        // session log, read it with --dump-session-journal)
+        constexpr bool SESSION_JOURNAL_ENABLED = false;
+        constexpr char SESSION_JOURNAL_FILE[] = "session_journal.bin";
+        constexpr char SESSION_JOURNAL_EXPORT_FILE[] = "session_journal.txt";
+        constexpr DWORD SESSION_JOURNAL_CAPACITY = 4096;  // records kept before the oldest is overwritten
+
+        // working-day calendar (holidays, part-time schedule, absences)
+        constexpr char CALENDAR_FILE[] = "calendar.txt";
+        constexpr int CALENDAR_FIRST_YEAR = 2000;
+        constexpr int CALENDAR_LAST_YEAR = 2099;
+
+        // log merge tool
+        constexpr size_t MERGE_MAX_FAN_IN = 64;  // inputs open at once, more are merged in passes
+        constexpr size_t MERGE_READ_BUFFER_SIZE = 64 * 1024;  // per input stream buffer
+
+        // log verifier
+        constexpr unsigned long long VERIFY_CHUNK_SIZE = 8ULL * 1024 * 1024;  // bytes scanned per task
+        constexpr unsigned long long VERIFY_BOUNDARY_WINDOW = 4096;  // bytes searched at once for a chunk's first line
+
+        // allocation report written on exit when built with TIME_TRACKER_ALLOC_TRACKING
+        constexpr char ALLOC_REPORT_FILE[] = "alloc_report.txt";
+        constexpr char ALLOC_SELF_TEST_LOG[] = "alloc_self_test.txt";  // scratch log of --self-test-alloc, deleted afterwards
+
+        // log viewer
+        constexpr size_t LOG_PAGER_INDEX_STRIDE = 64;  // lines between indexed offsets
+        constexpr unsigned long long LOG_PAGER_MAP_WINDOW = 16ULL * 1024 * 1024;  // bytes mapped at once
+        constexpr size_t LOG_VIEWER_PAGE_LINES = 100;
+        constexpr DWORD LOG_VIEWER_REFRESH_MS = 2000;  // pick up new entries while following the end
+        constexpr unsigned long long LOG_PAGER_INDEX_STEP = 32ULL * 1024 * 1024;  // bytes indexed per ui step
+        constexpr DWORD LOG_VIEWER_INDEX_MS = 50;  // ui steps while the index is built
+
         // window messages
         constexpr UINT WM_TRAY_ICON = WM_USER + 1;
         constexpr UINT TRAY_ICON_ID = 1001;
@@ -29,6 +61,8 @@ namespace time_tracker {
         constexpr UINT TIMER_ID_AUTO_BREAK = 1002;
         constexpr UINT TIMER_ID_MAX_HOURS = 1003;
         constexpr UINT TIMER_ID_STATUS_UPDATE = 1004;
+        constexpr UINT TIMER_ID_VIEWER_REFRESH = 1005;
+        constexpr UINT TIMER_ID_VIEWER_INDEX = 1006;
 
         // menu ids
         constexpr UINT ID_CLOCK_IN = 2001;
@@ -44,5 +78,14 @@ namespace time_tracker {
         constexpr UINT ID_INFO_WORKING_TIME = 3002;
         constexpr UINT ID_INFO_NEXT_BREAK = 3003;
         constexpr UINT ID_INFO_REMAINING = 3004;
+        constexpr UINT ID_INFO_BALANCE = 3005;
+
+        // log viewer controls
+        constexpr UINT ID_VIEWER_LIST = 4001;
+        constexpr UINT ID_VIEWER_OLDER = 4002;
+        constexpr UINT ID_VIEWER_NEWER = 4003;
+        constexpr UINT ID_VIEWER_LATEST = 4004;
+        constexpr UINT ID_VIEWER_DATE = 4005;
+        constexpr UINT ID_VIEWER_GO = 4006;
     }
 }
@@ -0,0 +1,50 @@
+#include "file_view.h"
+#include <algorithm>
+
+namespace time_tracker {
+    file_view::file_view(const std::string& path) {
+        // share everything so the tracker can keep appending or rewriting
+        file_ = CreateFileA(path.c_str(), GENERIC_READ,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return;
+
+        LARGE_INTEGER size{};
+        GetFileSizeEx(file_, &size);
+        GetFileTime(file_, nullptr, nullptr, &last_write_);
+        size_ = static_cast<std::uint64_t>(size.QuadPart);
+
+        // empty files cannot be mapped
+        if (size_ > 0) {
+            mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        }
+    }
+
+    file_view::~file_view() {
+        if (view_) UnmapViewOfFile(view_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+    }
+
+    const char* file_view::map(std::uint64_t offset, std::uint64_t& length) {
+        if (!mapping_ || offset >= size_) return nullptr;
+        if (view_) {
+            UnmapViewOfFile(view_);
+            view_ = nullptr;
+        }
+
+        SYSTEM_INFO info{};
+        GetSystemInfo(&info);
+        std::uint64_t base = offset - offset % info.dwAllocationGranularity;
+
+        length = std::min(length, size_ - offset);
+        std::uint64_t view_length = offset - base + length;
+
+        view_ = MapViewOfFile(mapping_, FILE_MAP_READ,
+            static_cast<DWORD>(base >> 32), static_cast<DWORD>(base & 0xFFFFFFFF),
+            static_cast<SIZE_T>(view_length));
+        if (!view_) return nullptr;
+
+        return static_cast<const char*>(view_) + (offset - base);
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "types.h"
+#include <cstdint>
+#include <string>
+
+namespace time_tracker {
+    // read-only mapping of a log file, views are mapped in windows so
+    // large logs also work in 32-bit builds. one view is mapped at a time,
+    // threads that read the same file in parallel each open their own.
+    class file_view {
+    private:
+        HANDLE file_{ INVALID_HANDLE_VALUE };
+        HANDLE mapping_{ nullptr };
+        void* view_{ nullptr };
+        std::uint64_t size_{ 0 };
+        FILETIME last_write_{};
+
+    public:
+        explicit file_view(const std::string& path);
+        ~file_view();
+
+        file_view(const file_view&) = delete;
+        file_view& operator=(const file_view&) = delete;
+
+        bool is_open() const { return file_ != INVALID_HANDLE_VALUE; }
+        std::uint64_t size() const { return size_; }
+        const FILETIME& last_write() const { return last_write_; }
+
+        // map up to length bytes at offset, length is clamped to the file size.
+        // the previous view is unmapped
+        const char* map(std::uint64_t offset, std::uint64_t& length);
+    };
+}
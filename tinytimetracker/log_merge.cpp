@@ -0,0 +1,322 @@
+#include "log_merge.h"
+#include "time_utils.h"
+#include "config.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <queue>
+#include <unordered_set>
+
+namespace time_tracker {
+    namespace log_merge {
+        namespace {
+            enum class event_kind {
+                clock_in,
+                clock_out,
+                break_start,
+                break_end,
+                auto_breaks,
+                other
+            };
+
+            event_kind classify(const std::string& line) {
+                // skip the timestamp and the optional automatic marker
+                size_t pos = time_utils::LOG_PREFIX_LENGTH;
+                if (line.compare(pos, 7, "[AUTO] ") == 0) {
+                    pos += 7;
+                }
+
+                auto is = [&](const char* action) { return line.compare(pos, std::string::npos, action) == 0; };
+                auto starts_with = [&](const char* action) { return line.compare(pos, std::strlen(action), action) == 0; };
+
+                if (is("CLOCK IN")) return event_kind::clock_in;
+                if (starts_with("CLOCK OUT")) return event_kind::clock_out;
+                if (is("BREAK START")) return event_kind::break_start;
+                if (starts_with("BREAK END")) return event_kind::break_end;
+                if (starts_with("AUTO BREAKS ADDED")) return event_kind::auto_breaks;
+                return event_kind::other;
+            }
+
+            struct input_stream {
+                std::unique_ptr<char[]> buffer;
+                std::ifstream file;
+                std::string line;
+                size_t index{ 0 };
+
+                // session state of this input
+                bool clocked_in{ false };
+                bool on_break{ false };
+            };
+
+            // read the next timestamped line, false at end of file
+            bool advance(input_stream& input, merge_stats& stats, bool count_input) {
+                while (std::getline(input.file, input.line)) {
+                    if (!input.line.empty() && input.line.back() == '\r') {
+                        input.line.pop_back();
+                    }
+                    if (input.line.empty()) continue;
+
+                    if (count_input) ++stats.lines_read;
+                    if (!time_utils::has_log_timestamp(input.line.data(), input.line.size())) {
+                        if (count_input) ++stats.malformed_lines;
+                        continue;
+                    }
+                    return true;
+                }
+                return false;
+            }
+
+            // lines seen and written within the current second, used for deduplication
+            class second_window {
+            private:
+                std::string timestamp_;
+                std::unordered_set<std::string> seen_;
+                std::unordered_set<std::string> written_;
+
+            public:
+                // returns false if the same line was already seen in this second
+                bool see(const std::string& line) {
+                    if (line.compare(0, time_utils::LOG_TIMESTAMP_LENGTH, timestamp_) != 0) {
+                        timestamp_.assign(line, 0, time_utils::LOG_TIMESTAMP_LENGTH);
+                        seen_.clear();
+                        written_.clear();
+                    }
+                    return seen_.insert(line).second;
+                }
+
+                bool write(std::ofstream& out, const std::string& line) {
+                    if (!written_.insert(line).second) return false;
+                    out << line << "\n";
+                    return true;
+                }
+            };
+
+            bool merge_group(const std::vector<std::string>& input_paths, const std::string& output_path,
+                merge_stats& stats, bool count_input, bool count_output) {
+
+                std::vector<std::unique_ptr<input_stream>> inputs;
+                inputs.reserve(input_paths.size());
+
+                for (size_t i = 0; i < input_paths.size(); ++i) {
+                    auto input = std::make_unique<input_stream>();
+                    input->index = i;
+                    input->buffer.reset(new char[config::MERGE_READ_BUFFER_SIZE]);
+                    input->file.rdbuf()->pubsetbuf(input->buffer.get(), config::MERGE_READ_BUFFER_SIZE);
+                    input->file.open(input_paths[i]);
+                    if (!input->file.is_open()) return false;
+                    inputs.push_back(std::move(input));
+                }
+
+                std::ofstream out(output_path, std::ios::trunc);
+                if (!out.is_open()) return false;
+
+                // min-heap on (timestamp, input index) so equal timestamps merge deterministically
+                auto later = [](const input_stream* a, const input_stream* b) {
+                    int order = a->line.compare(0, time_utils::LOG_TIMESTAMP_LENGTH,
+                        b->line, 0, time_utils::LOG_TIMESTAMP_LENGTH);
+                    return order > 0 || (order == 0 && a->index > b->index);
+                };
+                std::priority_queue<input_stream*, std::vector<input_stream*>, decltype(later)> heap(later);
+
+                for (auto& input : inputs) {
+                    if (advance(*input, stats, count_input)) {
+                        heap.push(input.get());
+                    }
+                }
+
+                second_window window;
+                size_t clocked_in_count = 0;
+                const input_stream* break_owner = nullptr;
+
+                // the merged session: its kept CLOCK IN, the latest event of an input that
+                // was clocked in, and whether it was left open by an input without CLOCK OUT
+                std::string session_start;
+                std::string last_active;
+                bool session_abandoned = false;
+
+                auto emit = [&](const std::string& line) {
+                    if (!window.write(out, line)) {
+                        ++stats.duplicates_dropped;
+                    }
+                    else if (count_output) {
+                        ++stats.lines_written;
+                    }
+                };
+
+                // the inputs' net times and automatic breaks only cover their own sessions,
+                // so they are recomputed for the merged one like clock_out does
+                auto close_session = [&](const std::string& timestamp, const char* marker) {
+                    std::chrono::system_clock::duration worked = std::chrono::seconds(
+                        time_utils::log_time_seconds(timestamp.c_str()) - time_utils::log_time_seconds(session_start.c_str()));
+                    auto required_breaks = time_utils::calculate_required_breaks(worked);
+
+                    if (required_breaks > std::chrono::minutes(0)) {
+                        emit(timestamp + " - [AUTO] AUTO BREAKS ADDED: " + time_utils::format_duration(required_breaks));
+                    }
+                    emit(timestamp + " - " + marker + "CLOCK OUT - Net Work Time: "
+                        + time_utils::format_duration(worked - required_breaks));
+                };
+
+                // an input's session ends without CLOCK OUT (a second CLOCK IN, or the input
+                // ends while clocked in). returns true if that leaves the merged session open
+                auto release = [&](input_stream& input) {
+                    if (!input.clocked_in) return false;
+
+                    input.clocked_in = false;
+                    input.on_break = false;
+                    if (break_owner == &input) {
+                        break_owner = nullptr;
+                    }
+                    if (count_input) {
+                        ++stats.unclosed_sessions;
+                    }
+                    return --clocked_in_count == 0;
+                };
+
+                auto next_line = [&](input_stream& input) {
+                    if (advance(input, stats, count_input)) {
+                        heap.push(&input);
+                    }
+                    else if (release(input)) {
+                        // closed when the next session starts. if none does, the input may
+                        // still be clocked in, so the merged session is left open
+                        session_abandoned = true;
+                    }
+                };
+
+                while (!heap.empty()) {
+                    input_stream* input = heap.top();
+                    heap.pop();
+
+                    const std::string& line = input->line;
+
+                    // a copy of an event already merged, e.g. the same log on two machines.
+                    // it must not reach the session policy, or the copied CLOCK IN would look
+                    // like a second machine clocking in and its breaks would be dropped
+                    if (!window.see(line)) {
+                        ++stats.duplicates_dropped;
+                        next_line(*input);
+                        continue;
+                    }
+
+                    std::string timestamp = line.substr(0, time_utils::LOG_TIMESTAMP_LENGTH);
+                    event_kind kind = classify(line);
+                    bool keep = false;
+
+                    if (input->clocked_in && kind != event_kind::clock_in) {
+                        last_active = timestamp;
+                    }
+
+                    switch (kind) {
+                    case event_kind::clock_in:
+                        if (release(*input)) {
+                            session_abandoned = true;
+                        }
+                        // end an abandoned session at its last activity before a new one starts
+                        if (session_abandoned) {
+                            close_session(last_active, "[AUTO] ");
+                            session_abandoned = false;
+                        }
+
+                        input->clocked_in = true;
+                        last_active = timestamp;
+                        keep = ++clocked_in_count == 1;
+                        if (keep) {
+                            session_start = timestamp;
+                        }
+                        break;
+                    case event_kind::clock_out:
+                        if (input->clocked_in) {
+                            input->clocked_in = false;
+                            input->on_break = false;
+                            keep = --clocked_in_count == 0;
+                            if (break_owner == input) {
+                                break_owner = nullptr;
+                            }
+                        }
+                        break;
+                    case event_kind::break_start:
+                        if (input->clocked_in && !input->on_break) {
+                            input->on_break = true;
+                            keep = clocked_in_count == 1 && !break_owner;
+                            if (keep) {
+                                break_owner = input;
+                            }
+                        }
+                        break;
+                    case event_kind::break_end:
+                        if (input->on_break) {
+                            input->on_break = false;
+                            keep = break_owner == input;
+                            if (keep) {
+                                break_owner = nullptr;
+                            }
+                        }
+                        break;
+                    case event_kind::auto_breaks:
+                        // replaced by the breaks of the merged session when it is clocked out
+                        break;
+                    case event_kind::other:
+                        keep = true;
+                        break;
+                    }
+
+                    if (keep && kind == event_kind::clock_out) {
+                        bool automatic = line.compare(time_utils::LOG_PREFIX_LENGTH, 7, "[AUTO] ") == 0;
+                        close_session(timestamp, automatic ? "[AUTO] " : "");
+                    }
+                    else if (keep) {
+                        emit(line);
+                    }
+                    else if (kind != event_kind::auto_breaks) {
+                        ++stats.overlaps_resolved;
+                    }
+
+                    next_line(*input);
+                }
+
+                out.close();
+                return !out.fail();
+            }
+        }
+
+        bool merge_logs(const std::vector<std::string>& input_paths, const std::string& output_path,
+            merge_stats& stats) {
+
+            std::vector<std::string> pending = input_paths;
+            std::vector<std::string> temp_files;
+            bool ok = true;
+
+            // bounded fan-in: merge groups into temporary files until one pass is left
+            for (size_t pass = 0; ok && pending.size() > config::MERGE_MAX_FAN_IN; ++pass) {
+                std::vector<std::string> next;
+
+                for (size_t first = 0; ok && first < pending.size(); first += config::MERGE_MAX_FAN_IN) {
+                    size_t last = std::min(first + config::MERGE_MAX_FAN_IN, pending.size());
+                    std::vector<std::string> group(pending.begin() + first, pending.begin() + last);
+
+                    std::string temp_path = output_path + ".pass" + std::to_string(pass) + "."
+                        + std::to_string(next.size()) + ".tmp";
+                    temp_files.push_back(temp_path);
+                    next.push_back(temp_path);
+
+                    ok = merge_group(group, temp_path, stats, pass == 0, false);
+                }
+
+                pending.swap(next);
+            }
+
+            if (ok) {
+                ok = merge_group(pending, output_path, stats, temp_files.empty(), true);
+            }
+
+            for (const auto& temp_path : temp_files) {
+                std::remove(temp_path.c_str());
+            }
+            return ok;
+        }
+    }
+}
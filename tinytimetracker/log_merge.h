@@ -0,0 +1,40 @@
+#pragma once
+#include "types.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace time_tracker {
+    namespace log_merge {
+        struct merge_stats {
+            std::size_t lines_read{ 0 };
+            std::size_t lines_written{ 0 };
+            std::size_t duplicates_dropped{ 0 };    // identical events seen in several inputs
+            std::size_t overlaps_resolved{ 0 };     // events dropped by the session policy
+            std::size_t malformed_lines{ 0 };       // lines without a leading timestamp
+            std::size_t unclosed_sessions{ 0 };     // input sessions without CLOCK OUT
+        };
+
+        // streaming k-way merge of time-ordered logs (time_log.txt, session_log.txt
+        // or journal exports) into one canonical history. only one line per input is
+        // held in memory; more than MERGE_MAX_FAN_IN inputs are merged in passes
+        // through temporary files next to the output.
+        //
+        // session policy: the merged history is clocked in while any input is
+        // clocked in. a CLOCK IN is kept when the first input clocks in, a CLOCK OUT
+        // when the last one clocks out. breaks are kept only while a single input
+        // is clocked in and must be ended by the input that started them. a line
+        // identical to one already merged in the same second (the same history on
+        // several machines) is dropped before the policy sees it.
+        //
+        // the kept CLOCK OUT gets the net time and automatic breaks of the merged
+        // session, computed from the kept CLOCK IN like the tracker does. an input
+        // session without CLOCK OUT (a second CLOCK IN, or the input ends clocked in)
+        // stops counting there. if that leaves the merged session open, an [AUTO]
+        // CLOCK OUT at its last activity is written before the next session starts;
+        // at the end of the merge it is left open, as the machine may still be
+        // clocked in.
+        bool merge_logs(const std::vector<std::string>& input_paths, const std::string& output_path,
+            merge_stats& stats);
+    }
+}
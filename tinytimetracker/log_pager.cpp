@@ -0,0 +1,231 @@
+#include "log_pager.h"
+#include "file_view.h"
+#include "time_utils.h"
+#include "config.h"
+#include <algorithm>
+#include <cstring>
+
+namespace time_tracker {
+    log_pager::log_pager(const std::string& path, bool append_only)
+        : path_(path)
+        , append_only_(append_only) {
+    }
+
+    void log_pager::reset_index() {
+        indexed_bytes_ = 0;
+        line_count_ = 0;
+        has_partial_line_ = false;
+        complete_ = false;
+        checkpoints_.clear();
+        first_day_ = 0;
+        day_lines_.clear();
+    }
+
+    void log_pager::index_range(const char* data, std::uint64_t end) {
+        const char* line = data;
+        const char* data_end = data + end;
+
+        while (line < data_end) {
+            auto newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(data_end - line)));
+            if (!newline) break;  // incomplete line, picked up by the next refresh
+
+            if (line_count_ % config::LOG_PAGER_INDEX_STRIDE == 0) {
+                checkpoints_.push_back(indexed_bytes_);
+            }
+
+            // lines are time ordered, so each new day points at its first line
+            int day = 0;
+            if (time_utils::parse_log_day(line, static_cast<size_t>(newline - line), day)) {
+                if (day_lines_.empty()) {
+                    first_day_ = day;
+                }
+                while (first_day_ + static_cast<std::int64_t>(day_lines_.size()) <= day) {
+                    day_lines_.push_back(line_count_);
+                }
+            }
+
+            ++line_count_;
+            indexed_bytes_ += static_cast<std::uint64_t>(newline + 1 - line);
+            line = newline + 1;
+        }
+    }
+
+    bool log_pager::refresh() {
+        return refresh(~0ULL);
+    }
+
+    bool log_pager::refresh(std::uint64_t max_bytes) {
+        file_view file(path_);
+        if (!file.is_open()) {
+            bool had_lines = line_count() > 0;
+            reset_index();
+            complete_ = true;
+            return had_lines;
+        }
+
+        bool changed = CompareFileTime(&file.last_write(), &last_write_) != 0;
+        bool rebuilt = file.size() < indexed_bytes_ || (changed && !append_only_);
+        if (rebuilt) {
+            reset_index();
+        }
+        last_write_ = file.last_write();
+
+        // only bytes after the indexed part are scanned
+        std::uint64_t lines_before = line_count();
+        std::uint64_t window = config::LOG_PAGER_MAP_WINDOW;
+        std::uint64_t scanned = 0;
+        complete_ = true;
+        while (indexed_bytes_ < file.size()) {
+            if (scanned >= max_bytes) {
+                complete_ = false;
+                break;
+            }
+
+            std::uint64_t length = window;
+            const char* data = file.map(indexed_bytes_, length);
+            if (!data) break;
+
+            std::uint64_t before = indexed_bytes_;
+            index_range(data, length);
+            scanned += length;
+
+            if (indexed_bytes_ == before) {
+                if (indexed_bytes_ + length >= file.size()) break;  // unterminated last line
+                window *= 2;  // a single line longer than the window
+            }
+        }
+
+        has_partial_line_ = complete_ && indexed_bytes_ < file.size();
+        return rebuilt || line_count() != lines_before;
+    }
+
+    std::uint64_t log_pager::line_count() const {
+        return line_count_ + (has_partial_line_ ? 1 : 0);
+    }
+
+    std::uint64_t log_pager::find_day(int day) const {
+        if (day_lines_.empty() || day < first_day_) return 0;
+
+        auto index = static_cast<std::uint64_t>(day - first_day_);
+        return index < day_lines_.size() ? day_lines_[static_cast<size_t>(index)] : line_count();
+    }
+
+    std::vector<std::string> log_pager::read_lines(std::uint64_t first_line, std::size_t count) {
+        std::vector<std::string> lines;
+        if (first_line >= line_count() || count == 0) return lines;
+
+        file_view file(path_);
+        if (!file.is_open()) return lines;
+
+        // start at the closest checkpoint, at most LOG_PAGER_INDEX_STRIDE lines before
+        std::uint64_t offset = indexed_bytes_;
+        std::uint64_t skip = 0;
+        if (first_line < line_count_) {
+            offset = checkpoints_[static_cast<size_t>(first_line / config::LOG_PAGER_INDEX_STRIDE)];
+            skip = first_line % config::LOG_PAGER_INDEX_STRIDE;
+        }
+
+        lines.reserve(count);
+        std::uint64_t window = config::LOG_PAGER_MAP_WINDOW;
+        while (lines.size() < count && offset < file.size()) {
+            std::uint64_t length = window;
+            const char* data = file.map(offset, length);
+            if (!data) break;
+
+            bool at_end = offset + length >= file.size();
+            std::uint64_t before = offset;
+            const char* line = data;
+            const char* data_end = data + length;
+
+            while (lines.size() < count && line < data_end) {
+                auto newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(data_end - line)));
+                if (!newline && !at_end) break;  // line continues past the window
+
+                const char* line_end = newline ? newline : data_end;
+                if (skip > 0) {
+                    --skip;
+                }
+                else {
+                    std::string text(line, line_end);
+                    if (!text.empty() && text.back() == '\r') {
+                        text.pop_back();
+                    }
+                    lines.push_back(text);
+                }
+
+                offset += static_cast<std::uint64_t>(line_end - line) + (newline ? 1 : 0);
+                line = newline ? newline + 1 : data_end;
+            }
+
+            if (offset == before) {
+                window *= 2;
+            }
+        }
+
+        return lines;
+    }
+
+    std::vector<std::string> log_pager::read_tail(std::size_t count) {
+        std::vector<std::string> lines;
+        file_view file(path_);
+        if (!file.is_open() || file.size() == 0 || count == 0) return lines;
+
+        // the line break that ends the last line does not start another one
+        std::uint64_t end = file.size();
+        std::uint64_t length = 1;
+        const char* last = file.map(end - 1, length);
+        if (!last) return lines;
+        std::uint64_t position = *last == '\n' ? end - 1 : end;
+
+        // the count-th line break from the end precedes the first wanted line
+        std::uint64_t begin = 0;
+        std::size_t breaks = 0;
+        while (position > 0 && breaks < count) {
+            length = std::min<std::uint64_t>(config::LOG_PAGER_MAP_WINDOW, position);
+            std::uint64_t offset = position - length;
+            const char* data = file.map(offset, length);
+            if (!data) return lines;
+
+            for (std::uint64_t i = length; i > 0 && breaks < count; --i) {
+                if (data[i - 1] == '\n' && ++breaks == count) {
+                    begin = offset + i;
+                }
+            }
+            position = offset;
+        }
+
+        length = end - begin;
+        const char* data = file.map(begin, length);
+        if (!data) return lines;
+
+        const char* line = data;
+        const char* data_end = data + length;
+        lines.reserve(count);
+        while (line < data_end) {
+            auto newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(data_end - line)));
+            const char* line_end = newline ? newline : data_end;
+
+            std::string text(line, line_end);
+            if (!text.empty() && text.back() == '\r') {
+                text.pop_back();
+            }
+            lines.push_back(text);
+            line = newline ? newline + 1 : data_end;
+        }
+        return lines;
+    }
+
+    std::vector<std::string> log_pager::read_latest(std::size_t count) {
+        // a complete index only scans what was appended since, a rewritten log
+        // starts over in steps and is read from the end meanwhile
+        if (complete_) {
+            refresh(config::LOG_PAGER_INDEX_STEP);
+        }
+        if (!complete_) {
+            return read_tail(count);
+        }
+
+        std::uint64_t total = line_count();
+        return read_lines(total > count ? total - count : 0, count);
+    }
+}
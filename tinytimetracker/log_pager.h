@@ -0,0 +1,64 @@
+#pragma once
+#include "types.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace time_tracker {
+    // paging over a text log through a sparse line-offset index. the file is
+    // memory-mapped only while the index is extended or a page is read, so the
+    // tracker can keep appending to (or rewriting) it. no ui code, so it can be
+    // used from the tray viewer and from console tools alike.
+    class log_pager {
+    private:
+        std::string path_;
+        bool append_only_;
+
+        std::uint64_t indexed_bytes_{ 0 };   // end of the last complete indexed line
+        std::uint64_t line_count_{ 0 };      // complete lines in the index
+        bool has_partial_line_{ false };     // unterminated text after indexed_bytes_
+        bool complete_{ false };             // the index reached the end of the file
+        FILETIME last_write_{};
+
+        std::vector<std::uint64_t> checkpoints_;  // offset of every LOG_PAGER_INDEX_STRIDE-th line
+
+        // first line on or after each day, from the first dated line onwards
+        int first_day_{ 0 };
+        std::vector<std::uint64_t> day_lines_;
+
+        void reset_index();
+        void index_range(const char* data, std::uint64_t end);
+
+        // the last count lines, found by scanning backwards from the end of the file
+        std::vector<std::string> read_tail(std::size_t count);
+
+    public:
+        // append_only: the file only grows at the end (time log); otherwise any
+        // change rebuilds the index (weekly hours are rewritten in place)
+        log_pager(const std::string& path, bool append_only);
+
+        // pick up changes to the file, only new bytes are scanned for append-only logs.
+        // returns true if the index changed
+        bool refresh();
+
+        // like refresh, but stops after about max_bytes so a large log can be indexed
+        // in steps between ui messages. the index is usable once complete() is true
+        bool refresh(std::uint64_t max_bytes);
+        bool complete() const { return complete_; }
+
+        // number of lines, including an unterminated last line
+        std::uint64_t line_count() const;
+
+        // first line dated on or after the given day number (see time_utils::day_number)
+        std::uint64_t find_day(int day) const;
+
+        // up to count lines starting at first_line
+        std::vector<std::string> read_lines(std::uint64_t first_line, std::size_t count);
+
+        // the last count lines. until the index is complete they are read backwards
+        // from the end of the file, so they show instantly however large the log is
+        std::vector<std::string> read_latest(std::size_t count);
+
+        const std::string& path() const { return path_; }
+    };
+}
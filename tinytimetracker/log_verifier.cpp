@@ -0,0 +1,577 @@
+#include "log_verifier.h"
+#include "file_view.h"
+#include "work_calendar.h"
+#include "time_utils.h"
+#include "config.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <thread>
+
+namespace time_tracker {
+    namespace log_verifier {
+        namespace {
+            enum class event_kind {
+                clock_in,
+                clock_out,
+                break_start,
+                break_end,
+                other
+            };
+
+            constexpr char NET_WORK_TIME[] = "CLOCK OUT - Net Work Time: ";
+
+            // timestamp of a log line, the text is kept for messages and repair lines
+            struct stamp {
+                bool known{ false };
+                std::int64_t seconds{ 0 };
+                char text[time_utils::LOG_TIMESTAMP_LENGTH + 1]{};
+            };
+
+            struct event {
+                event_kind kind;
+                std::uint64_t offset;
+                std::uint64_t length;   // including the line break
+                stamp time;
+                stamp previous;         // line before, unknown if it is in an earlier chunk
+                bool has_net;           // CLOCK OUT with a readable net work time
+                std::chrono::minutes net;
+            };
+
+            struct session_state {
+                work_state status{ work_state::clocked_out };
+                std::uint64_t clock_in_offset{ 0 };
+                stamp clock_in;
+                stamp last;             // last timestamped line before the next event
+            };
+
+            // the day's CLOCK OUT net times added up, which is what update_weekly_hours
+            // writes. offset and time are the day's last CLOCK OUT
+            struct day_total {
+                int day;
+                std::chrono::minutes net;
+                std::uint64_t offset;
+                stamp time;
+            };
+
+            void add_to(day_total& total, const day_total& later) {
+                total.net += later.net;
+                total.offset = later.offset;
+                total.time = later.time;
+            }
+
+            // totals are added in file order, so a day's CLOCK OUTs are next to each other
+            void add_day(std::vector<day_total>& days, const day_total& total) {
+                if (!days.empty() && days.back().day == total.day) {
+                    add_to(days.back(), total);
+                }
+                else {
+                    days.push_back(total);
+                }
+            }
+
+            // what one chunk contributes. the session state at a chunk's start is only
+            // known after stitching, so its events up to the first CLOCK IN / CLOCK OUT
+            // are kept and replayed then; from there on the chunk is checked on its own
+            struct chunk_summary {
+                std::uint64_t begin{ 0 };
+                std::uint64_t end{ 0 };
+                bool read_failed{ false };
+                std::uint64_t lines{ 0 };
+
+                std::vector<event> prefix;
+                bool synchronized{ false };     // prefix ends in a CLOCK IN or CLOCK OUT
+                session_state state;            // state at the end, if synchronized
+
+                stamp first;                    // first and last timestamped lines
+                std::uint64_t first_offset{ 0 };
+                stamp last;
+                std::int64_t min_seconds{ 0 };
+                std::int64_t max_seconds{ 0 };
+
+                std::vector<day_total> days;
+                std::vector<issue> issues;
+                std::vector<repair> repairs;
+            };
+
+            // line must start with a valid log timestamp (see has_log_timestamp)
+            stamp parse_stamp(const char* line) {
+                stamp time;
+                time.known = true;
+                time.seconds = time_utils::log_time_seconds(line);
+                std::memcpy(time.text, line, time_utils::LOG_TIMESTAMP_LENGTH);
+                return time;
+            }
+
+            int day_of(const stamp& time) {
+                return static_cast<int>(time.seconds >= 0 ? time.seconds / 86400 : (time.seconds - 86399) / 86400);
+            }
+
+            // action is moved past the optional automatic marker
+            event_kind classify(const char*& action, const char* end) {
+                auto length = static_cast<size_t>(end - action);
+                if (length >= 7 && std::memcmp(action, "[AUTO] ", 7) == 0) {
+                    action += 7;
+                    length -= 7;
+                }
+
+                auto is = [&](const char* name) {
+                    return std::strlen(name) == length && std::memcmp(action, name, length) == 0;
+                };
+                auto starts_with = [&](const char* name) {
+                    size_t name_length = std::strlen(name);
+                    return name_length <= length && std::memcmp(action, name, name_length) == 0;
+                };
+
+                if (is("CLOCK IN")) return event_kind::clock_in;
+                if (starts_with("CLOCK OUT")) return event_kind::clock_out;
+                if (is("BREAK START")) return event_kind::break_start;
+                if (starts_with("BREAK END")) return event_kind::break_end;
+                return event_kind::other;
+            }
+
+            // the lines the tracker would have written had it clocked out at the
+            // session's last entry, counted in that day's total like a real CLOCK OUT
+            void add_missing_clock_out(const session_state& state, std::uint64_t offset,
+                std::vector<repair>& repairs, std::vector<day_total>& days) {
+                const stamp& at = state.last.known && state.last.seconds >= state.clock_in.seconds ? state.last : state.clock_in;
+                std::chrono::system_clock::duration worked = std::chrono::seconds(at.seconds - state.clock_in.seconds);
+                auto required_breaks = time_utils::calculate_required_breaks(worked);
+                auto net = std::chrono::duration_cast<std::chrono::minutes>(worked - required_breaks);
+
+                std::string timestamp(at.text);
+                if (required_breaks > std::chrono::minutes(0)) {
+                    repairs.push_back({ repair::operation::insert_line, log_file::time_log, offset, 0,
+                        timestamp + " - [AUTO] AUTO BREAKS ADDED: " + time_utils::format_duration(required_breaks) });
+                }
+                repairs.push_back({ repair::operation::insert_line, log_file::time_log, offset, 0,
+                    timestamp + " - [AUTO] CLOCK OUT - Net Work Time: " + time_utils::format_duration(net) });
+                add_day(days, { day_of(at), net, offset, at });
+            }
+
+            void remove_line(const event& e, std::vector<repair>& repairs) {
+                repairs.push_back({ repair::operation::delete_line, log_file::time_log, e.offset, e.length, std::string() });
+            }
+
+            // session state machine, used inside chunks and when stitching them.
+            // state.last must hold the line before the event. only the CLOCK OUTs it
+            // keeps count towards the day totals, deleted ones would not be in a repaired log
+            void apply(session_state& state, const event& e, std::vector<issue>& issues,
+                std::vector<repair>& repairs, std::vector<day_total>& days) {
+                switch (e.kind) {
+                case event_kind::clock_in:
+                    if (state.status != work_state::clocked_out) {
+                        issues.push_back({ issue_kind::clock_in_without_clock_out, log_file::time_log, state.clock_in_offset,
+                            std::string("CLOCK IN at ") + state.clock_in.text + " is followed by another CLOCK IN at " + e.time.text });
+                        add_missing_clock_out(state, e.offset, repairs, days);
+                    }
+                    state.status = work_state::clocked_in;
+                    state.clock_in_offset = e.offset;
+                    state.clock_in = e.time;
+                    break;
+                case event_kind::clock_out:
+                    // clocking out during a break ends the break without a BREAK END
+                    if (state.status == work_state::clocked_out) {
+                        issues.push_back({ issue_kind::clock_out_without_clock_in, log_file::time_log, e.offset,
+                            std::string("CLOCK OUT at ") + e.time.text });
+                        remove_line(e, repairs);
+                    }
+                    else if (e.has_net) {
+                        add_day(days, { day_of(e.time), e.net, e.offset, e.time });
+                    }
+                    state.status = work_state::clocked_out;
+                    break;
+                case event_kind::break_start:
+                    if (state.status == work_state::clocked_out) {
+                        issues.push_back({ issue_kind::break_outside_session, log_file::time_log, e.offset,
+                            std::string("BREAK START at ") + e.time.text });
+                        remove_line(e, repairs);
+                    }
+                    else {
+                        state.status = work_state::on_break;
+                    }
+                    break;
+                case event_kind::break_end:
+                    if (state.status == work_state::on_break) {
+                        state.status = work_state::clocked_in;
+                    }
+                    else {
+                        issues.push_back({ state.status == work_state::clocked_out ? issue_kind::break_outside_session
+                            : issue_kind::break_end_without_break_start, log_file::time_log, e.offset,
+                            std::string("BREAK END at ") + e.time.text });
+                        remove_line(e, repairs);
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            // offset of the first line that starts at or after offset (> 0)
+            std::uint64_t next_line_start(file_view& file, std::uint64_t offset) {
+                // a line starts right after a newline, so search from the byte before
+                std::uint64_t position = offset - 1;
+                while (position < file.size()) {
+                    std::uint64_t length = config::VERIFY_BOUNDARY_WINDOW;
+                    const char* data = file.map(position, length);
+                    if (!data) break;
+
+                    auto newline = static_cast<const char*>(std::memchr(data, '\n', static_cast<size_t>(length)));
+                    if (newline) {
+                        return position + static_cast<std::uint64_t>(newline - data) + 1;
+                    }
+                    position += length;
+                }
+                return file.size();
+            }
+
+            void scan_chunk(file_view& file, chunk_summary& chunk) {
+                std::uint64_t length = chunk.end - chunk.begin;
+                const char* data = file.map(chunk.begin, length);
+                if (!data || length != chunk.end - chunk.begin) {
+                    chunk.read_failed = true;  // truncated since it was split
+                    return;
+                }
+
+                session_state state;
+                stamp previous;
+                const char* line = data;
+                const char* data_end = data + length;
+
+                while (line < data_end) {
+                    auto newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(data_end - line)));
+                    const char* next = newline ? newline + 1 : data_end;
+                    const char* line_end = newline ? newline : data_end;
+                    if (line_end > line && line_end[-1] == '\r') {
+                        --line_end;
+                    }
+
+                    std::uint64_t offset = chunk.begin + static_cast<std::uint64_t>(line - data);
+                    auto text_length = static_cast<size_t>(line_end - line);
+                    ++chunk.lines;
+
+                    if (text_length == 0) {
+                        line = next;
+                        continue;
+                    }
+                    if (!time_utils::has_log_timestamp(line, text_length)) {
+                        chunk.issues.push_back({ issue_kind::malformed_line, log_file::time_log, offset,
+                            std::string(line, std::min<size_t>(text_length, 80)) });
+                        line = next;
+                        continue;
+                    }
+
+                    stamp time = parse_stamp(line);
+                    if (!previous.known) {
+                        chunk.first = time;
+                        chunk.first_offset = offset;
+                        chunk.min_seconds = chunk.max_seconds = time.seconds;
+                    }
+                    else {
+                        if (time.seconds < previous.seconds) {
+                            chunk.issues.push_back({ issue_kind::timestamp_out_of_order, log_file::time_log, offset,
+                                std::string(time.text) + " follows " + previous.text });
+                        }
+                        chunk.min_seconds = std::min(chunk.min_seconds, time.seconds);
+                        chunk.max_seconds = std::max(chunk.max_seconds, time.seconds);
+                    }
+
+                    const char* action = line + time_utils::LOG_PREFIX_LENGTH;
+                    event e{ classify(action, line_end), offset, static_cast<std::uint64_t>(next - line), time, previous,
+                        false, std::chrono::minutes(0) };
+
+                    if (e.kind == event_kind::clock_out) {
+                        const size_t prefix_length = sizeof(NET_WORK_TIME) - 1;
+                        e.has_net = static_cast<size_t>(line_end - action) > prefix_length
+                            && std::memcmp(action, NET_WORK_TIME, prefix_length) == 0
+                            && time_utils::parse_duration(action + prefix_length, line_end, e.net);
+                    }
+
+                    if (e.kind != event_kind::other) {
+                        if (chunk.synchronized) {
+                            state.last = previous;
+                            apply(state, e, chunk.issues, chunk.repairs, chunk.days);
+                        }
+                        else {
+                            chunk.prefix.push_back(e);
+
+                            // every state ends up the same after these
+                            if (e.kind == event_kind::clock_in || e.kind == event_kind::clock_out) {
+                                chunk.synchronized = true;
+                                state.status = e.kind == event_kind::clock_in ? work_state::clocked_in : work_state::clocked_out;
+                                state.clock_in_offset = offset;
+                                state.clock_in = time;
+                            }
+                        }
+                    }
+
+                    previous = time;
+                    line = next;
+                }
+
+                chunk.last = previous;
+                state.last = previous;
+                chunk.state = state;
+            }
+
+            // weekly_hours.txt holds "YYYY-MM-DD - 7h 45m", one line per day
+            void verify_weekly(const std::string& path, const std::map<int, day_total>& days,
+                int first_day, int last_day, verify_result& result) {
+                std::ifstream file(path, std::ios::binary);
+                std::set<int> listed;
+                std::string line;
+                std::uint64_t offset = 0;
+
+                while (std::getline(file, line)) {
+                    std::uint64_t line_offset = offset;
+                    offset += line.size() + (file.eof() ? 0 : 1);
+
+                    if (!line.empty() && line.back() == '\r') {
+                        line.pop_back();
+                    }
+                    if (line.empty()) continue;
+
+                    int day = 0;
+                    std::chrono::minutes hours{ 0 };
+                    if (!time_utils::parse_weekly_line(line.data(), line.size(), day, hours)) {
+                        result.issues.push_back({ issue_kind::malformed_line, log_file::weekly_log, line_offset, line.substr(0, 80) });
+                        continue;
+                    }
+
+                    // days before or after the time log cannot be checked
+                    if (day < first_day || day > last_day) continue;
+                    listed.insert(day);
+
+                    auto total = days.find(day);
+                    if (total == days.end()) {
+                        result.issues.push_back({ issue_kind::weekly_total_mismatch, log_file::weekly_log, line_offset,
+                            line + ", but the time log has no CLOCK OUT that day" });
+                    }
+                    else if (total->second.net != hours) {
+                        std::string expected = line.substr(0, 10) + " - " + time_utils::format_duration(total->second.net);
+                        result.issues.push_back({ issue_kind::weekly_total_mismatch, log_file::weekly_log, line_offset,
+                            line + ", but the CLOCK OUT lines up to " + total->second.time.text + " add up to "
+                            + time_utils::format_duration(total->second.net) });
+                        result.repairs.push_back({ repair::operation::set_weekly, log_file::weekly_log, line_offset, 0, expected });
+                    }
+                }
+
+                for (const auto& entry : days) {
+                    if (listed.count(entry.first)) continue;
+
+                    const day_total& total = entry.second;
+                    std::string expected = std::string(total.time.text, 10) + " - " + time_utils::format_duration(total.net);
+                    result.issues.push_back({ issue_kind::weekly_total_mismatch, log_file::time_log, total.offset,
+                        std::string("CLOCK OUT at ") + total.time.text + " has no weekly total" });
+                    result.repairs.push_back({ repair::operation::set_weekly, log_file::weekly_log, 0, 0, expected });
+                }
+            }
+
+            const std::string& path_of(const verify_result& result, log_file file) {
+                return file == log_file::time_log ? result.time_log_path : result.weekly_log_path;
+            }
+        }
+
+        bool verify_logs(const std::string& time_log_path, const std::string& weekly_log_path,
+            verify_result& result) {
+            result = verify_result();
+            result.time_log_path = time_log_path;
+            result.weekly_log_path = weekly_log_path;
+
+            // split at line boundaries, so every line belongs to exactly one chunk
+            std::vector<chunk_summary> chunks;
+            std::uint64_t size = 0;
+            {
+                file_view file(time_log_path);
+                if (!file.is_open()) return false;
+
+                size = file.size();
+                std::uint64_t begin = 0;
+                while (begin < size) {
+                    std::uint64_t end = size;
+                    if (size - begin > config::VERIFY_CHUNK_SIZE) {
+                        end = next_line_start(file, begin + config::VERIFY_CHUNK_SIZE);
+                    }
+
+                    chunk_summary chunk;
+                    chunk.begin = begin;
+                    chunk.end = end;
+                    chunks.push_back(std::move(chunk));
+                    begin = end;
+                }
+            }
+
+            result.bytes_scanned = size;
+            result.chunks = chunks.size();
+            result.threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), std::max<size_t>(chunks.size(), 1));
+
+            // each thread maps its own views of the file
+            std::atomic<size_t> next_chunk{ 0 };
+            auto worker = [&]() {
+                file_view file(time_log_path);
+                for (size_t i = next_chunk++; i < chunks.size(); i = next_chunk++) {
+                    scan_chunk(file, chunks[i]);
+                }
+            };
+
+            std::vector<std::thread> threads;
+            for (size_t i = 1; i < result.threads; ++i) {
+                threads.emplace_back(worker);
+            }
+            worker();
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            // stitch in file order
+            session_state carry;
+            std::map<int, day_total> days;
+            std::vector<day_total> stitched;    // totals from the replayed events
+
+            // a day can span two chunks
+            auto add_days = [&](const std::vector<day_total>& totals) {
+                for (const auto& total : totals) {
+                    auto known = days.find(total.day);
+                    if (known == days.end()) {
+                        days.emplace(total.day, total);
+                    }
+                    else {
+                        add_to(known->second, total);
+                    }
+                }
+            };
+            bool any_line = false;
+            std::int64_t min_seconds = 0;
+            std::int64_t max_seconds = 0;
+
+            for (auto& chunk : chunks) {
+                if (chunk.read_failed) return false;
+                result.lines_scanned += chunk.lines;
+
+                if (chunk.first.known) {
+                    if (carry.last.known && chunk.first.seconds < carry.last.seconds) {
+                        result.issues.push_back({ issue_kind::timestamp_out_of_order, log_file::time_log, chunk.first_offset,
+                            std::string(chunk.first.text) + " follows " + carry.last.text });
+                    }
+
+                    min_seconds = any_line ? std::min(min_seconds, chunk.min_seconds) : chunk.min_seconds;
+                    max_seconds = any_line ? std::max(max_seconds, chunk.max_seconds) : chunk.max_seconds;
+                    any_line = true;
+                }
+
+                stitched.clear();
+                for (const auto& e : chunk.prefix) {
+                    if (e.previous.known) {
+                        carry.last = e.previous;
+                    }
+                    apply(carry, e, result.issues, result.repairs, stitched);
+                }
+
+                if (chunk.synchronized) {
+                    carry = chunk.state;
+                }
+                else if (chunk.last.known) {
+                    carry.last = chunk.last;
+                }
+
+                // the prefix comes before the rest of the chunk
+                add_days(stitched);
+                add_days(chunk.days);
+                std::move(chunk.issues.begin(), chunk.issues.end(), std::back_inserter(result.issues));
+                std::move(chunk.repairs.begin(), chunk.repairs.end(), std::back_inserter(result.repairs));
+                chunk = chunk_summary();
+            }
+
+            // a session with entries from today is most likely still running. an older one
+            // means the tracker crashed or was killed before it could clock out
+            if (carry.status != work_state::clocked_out) {
+                const stamp& latest = carry.last.known ? carry.last : carry.clock_in;
+                if (day_of(latest) == work_calendar::today()) {
+                    result.notes.push_back({ issue_kind::clock_in_without_clock_out, log_file::time_log, carry.clock_in_offset,
+                        std::string("CLOCK IN at ") + carry.clock_in.text + " is still open, the session is running today" });
+                }
+                else {
+                    result.issues.push_back({ issue_kind::clock_in_without_clock_out, log_file::time_log, carry.clock_in_offset,
+                        std::string("CLOCK IN at ") + carry.clock_in.text + " is still open at the end of the log" });
+                    stitched.clear();
+                    add_missing_clock_out(carry, size, result.repairs, stitched);
+                    add_days(stitched);
+                }
+            }
+
+            if (!weekly_log_path.empty() && any_line) {
+                stamp first, last;
+                first.seconds = min_seconds;
+                last.seconds = max_seconds;
+                verify_weekly(weekly_log_path, days, day_of(first), day_of(last), result);
+            }
+
+            // stable, so inserts at the same offset keep their order
+            std::stable_sort(result.issues.begin(), result.issues.end(), [](const issue& a, const issue& b) {
+                if (a.file != b.file) return a.file < b.file;
+                return a.offset != b.offset ? a.offset < b.offset : a.kind < b.kind;
+            });
+            std::stable_sort(result.repairs.begin(), result.repairs.end(), [](const repair& a, const repair& b) {
+                return a.file != b.file ? a.file < b.file : a.offset < b.offset;
+            });
+            return true;
+        }
+
+        const char* describe(issue_kind kind) {
+            switch (kind) {
+            case issue_kind::clock_in_without_clock_out: return "CLOCK IN without CLOCK OUT";
+            case issue_kind::clock_out_without_clock_in: return "CLOCK OUT without CLOCK IN";
+            case issue_kind::break_end_without_break_start: return "BREAK END without BREAK START";
+            case issue_kind::break_outside_session: return "break while clocked out";
+            case issue_kind::timestamp_out_of_order: return "timestamp out of order";
+            case issue_kind::malformed_line: return "line without timestamp";
+            case issue_kind::weekly_total_mismatch: return "weekly total disagrees with time log";
+            }
+            return "unknown issue";
+        }
+
+        void write_issues(const verify_result& result, std::ostream& out) {
+            for (const auto& found : result.issues) {
+                out << path_of(result, found.file) << ":" << found.offset << ": "
+                    << describe(found.kind) << " - " << found.detail << "\n";
+            }
+        }
+
+        void write_notes(const verify_result& result, std::ostream& out) {
+            for (const auto& note : result.notes) {
+                out << path_of(result, note.file) << ":" << note.offset << ": note - " << note.detail << "\n";
+            }
+        }
+
+        void write_repair_plan(const verify_result& result, std::ostream& out) {
+            out << "# repair plan for " << result.time_log_path;
+            if (!result.weekly_log_path.empty()) {
+                out << " and " << result.weekly_log_path;
+            }
+            out << "\n# byte offsets refer to the files as verified, lines inserted at the same offset keep their order\n"
+                << "# insert \"<file>\" <offset> <line>  - insert a line before the line at offset\n"
+                << "# delete \"<file>\" <offset> <bytes> - remove the line at offset\n"
+                << "# set \"<file>\" <line>              - replace or add the weekly total of that day\n";
+
+            for (const auto& edit : result.repairs) {
+                const std::string& path = path_of(result, edit.file);
+                switch (edit.op) {
+                case repair::operation::insert_line:
+                    out << "insert \"" << path << "\" " << edit.offset << " " << edit.text << "\n";
+                    break;
+                case repair::operation::delete_line:
+                    out << "delete \"" << path << "\" " << edit.offset << " " << edit.length << "\n";
+                    break;
+                case repair::operation::set_weekly:
+                    out << "set \"" << path << "\" " << edit.text << "\n";
+                    break;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace time_tracker {
+    namespace log_verifier {
+        enum class issue_kind {
+            clock_in_without_clock_out,
+            clock_out_without_clock_in,
+            break_end_without_break_start,
+            break_outside_session,          // BREAK START or BREAK END while clocked out
+            timestamp_out_of_order,         // earlier than the line before it
+            malformed_line,                 // no leading timestamp (e.g. torn write)
+            weekly_total_mismatch           // weekly_hours.txt disagrees with the time log
+        };
+
+        enum class log_file {
+            time_log,
+            weekly_log
+        };
+
+        struct issue {
+            issue_kind kind;
+            log_file file;                  // file the offset points into
+            std::uint64_t offset;           // byte offset of the line
+            std::string detail;
+        };
+
+        // suggested edit, offsets refer to the files as verified
+        struct repair {
+            enum class operation {
+                insert_line,    // insert text as a new line before the line at offset
+                delete_line,    // remove length bytes (one whole line) at offset
+                set_weekly      // replace or add the day's weekly_hours.txt line with text
+            };
+
+            operation op;
+            log_file file;
+            std::uint64_t offset;
+            std::uint64_t length;
+            std::string text;
+        };
+
+        struct verify_result {
+            std::string time_log_path;
+            std::string weekly_log_path;
+
+            std::uint64_t bytes_scanned{ 0 };
+            std::uint64_t lines_scanned{ 0 };
+            std::size_t chunks{ 0 };
+            std::size_t threads{ 0 };
+
+            std::vector<issue> issues;      // ordered by file and offset
+            std::vector<repair> repairs;
+            std::vector<issue> notes;       // not counted as issues and not repaired, e.g. today's open session
+        };
+
+        // check a time log for broken sessions and out-of-order or torn lines, and
+        // the weekly log (optional, empty path to skip) against the time log's
+        // CLOCK OUT totals summed per day as the repair plan would leave them: CLOCK OUTs
+        // it deletes are not counted, the ones it inserts are. the time log is split into VERIFY_CHUNK_SIZE chunks at
+        // line boundaries, scanned on all cores and stitched in file order.
+        // returns false if the time log cannot be read
+        bool verify_logs(const std::string& time_log_path, const std::string& weekly_log_path,
+            verify_result& result);
+
+        const char* describe(issue_kind kind);
+
+        // one issue per line: "<path>:<offset>: <description> - <detail>"
+        void write_issues(const verify_result& result, std::ostream& out);
+
+        // one note per line: "<path>:<offset>: note - <detail>"
+        void write_notes(const verify_result& result, std::ostream& out);
+
+        // one edit per line: "insert|delete|set <path> ..." for a person or script to apply
+        void write_repair_plan(const verify_result& result, std::ostream& out);
+    }
+}
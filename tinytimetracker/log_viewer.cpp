@@ -0,0 +1,255 @@
+#include "log_viewer.h"
+#include "time_utils.h"
+#include "config.h"
+
+namespace time_tracker {
+    namespace {
+        const wchar_t VIEWER_CLASS_NAME[] = L"TimeTrackerLogViewer";
+
+        HWND create_control(const wchar_t* class_name, const wchar_t* text, DWORD style, HWND parent, UINT id) {
+            HWND control = CreateWindow(class_name, text, WS_CHILD | WS_VISIBLE | style,
+                0, 0, 0, 0, parent, reinterpret_cast<HMENU>(static_cast<UINT_PTR>(id)),
+                GetModuleHandle(nullptr), nullptr);
+            SendMessage(control, WM_SETFONT, reinterpret_cast<WPARAM>(GetStockObject(DEFAULT_GUI_FONT)), TRUE);
+            return control;
+        }
+
+        std::wstring range_status(std::uint64_t first_line, size_t count, std::uint64_t total) {
+            if (count == 0) return L"No entries";
+            return L"Lines " + std::to_wstring(first_line + 1) + L" - "
+                + std::to_wstring(first_line + count) + L" of " + std::to_wstring(total);
+        }
+    }
+
+    log_viewer::log_viewer(log_pager& pager)
+        : pager_(pager) {
+    }
+
+    void log_viewer::show(log_pager& pager, const std::wstring& title) {
+        static bool registered = false;
+        HINSTANCE instance = GetModuleHandle(nullptr);
+
+        if (!registered) {
+            // date picker for seeking
+            INITCOMMONCONTROLSEX controls{ sizeof(INITCOMMONCONTROLSEX), ICC_DATE_CLASSES };
+            InitCommonControlsEx(&controls);
+
+            WNDCLASS wc = {};
+            wc.lpfnWndProc = window_proc;
+            wc.hInstance = instance;
+            wc.lpszClassName = VIEWER_CLASS_NAME;
+            wc.hCursor = LoadCursor(nullptr, IDC_ARROW);
+            wc.hbrBackground = reinterpret_cast<HBRUSH>(COLOR_BTNFACE + 1);
+            registered = RegisterClass(&wc) != 0;
+            if (!registered) return;
+        }
+
+        auto viewer = new log_viewer(pager);
+        HWND hwnd = CreateWindow(
+            VIEWER_CLASS_NAME,
+            title.c_str(),
+            WS_OVERLAPPEDWINDOW,
+            CW_USEDEFAULT, CW_USEDEFAULT, 760, 520,
+            nullptr,
+            nullptr,
+            instance,
+            viewer
+        );
+
+        if (!hwnd) {
+            delete viewer;
+            return;
+        }
+
+        ShowWindow(hwnd, SW_SHOWNORMAL);
+        SetForegroundWindow(hwnd);
+    }
+
+    LRESULT CALLBACK log_viewer::window_proc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam) {
+        log_viewer* viewer = nullptr;
+        if (msg == WM_NCCREATE) {
+            auto create = reinterpret_cast<CREATESTRUCT*>(lparam);
+            viewer = static_cast<log_viewer*>(create->lpCreateParams);
+            viewer->window_ = hwnd;
+            SetWindowLongPtr(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(viewer));
+        }
+        else {
+            viewer = reinterpret_cast<log_viewer*>(GetWindowLongPtr(hwnd, GWLP_USERDATA));
+        }
+
+        if (!viewer) {
+            return DefWindowProc(hwnd, msg, wparam, lparam);
+        }
+
+        switch (msg) {
+        case WM_CREATE:
+            viewer->create_controls();
+            viewer->show_latest();
+            SetTimer(hwnd, config::TIMER_ID_VIEWER_REFRESH, config::LOG_VIEWER_REFRESH_MS, nullptr);
+            if (!viewer->pager_.complete()) {
+                SetTimer(hwnd, config::TIMER_ID_VIEWER_INDEX, config::LOG_VIEWER_INDEX_MS, nullptr);
+            }
+            return 0;
+        case WM_SIZE:
+            viewer->layout(LOWORD(lparam), HIWORD(lparam));
+            return 0;
+        case WM_COMMAND:
+            viewer->handle_command(LOWORD(wparam));
+            return 0;
+        case WM_TIMER:
+            if (wparam == config::TIMER_ID_VIEWER_REFRESH) {
+                viewer->follow_end();
+            }
+            else if (wparam == config::TIMER_ID_VIEWER_INDEX) {
+                viewer->index_step();
+            }
+            return 0;
+        case WM_DESTROY:
+            KillTimer(hwnd, config::TIMER_ID_VIEWER_REFRESH);
+            KillTimer(hwnd, config::TIMER_ID_VIEWER_INDEX);
+            return 0;
+        case WM_NCDESTROY:
+            SetWindowLongPtr(hwnd, GWLP_USERDATA, 0);
+            delete viewer;
+            return DefWindowProc(hwnd, msg, wparam, lparam);
+        default:
+            return DefWindowProc(hwnd, msg, wparam, lparam);
+        }
+    }
+
+    void log_viewer::create_controls() {
+        create_control(L"BUTTON", L"< Older", BS_PUSHBUTTON, window_, config::ID_VIEWER_OLDER);
+        create_control(L"BUTTON", L"Newer >", BS_PUSHBUTTON, window_, config::ID_VIEWER_NEWER);
+        create_control(L"BUTTON", L"Latest >>", BS_PUSHBUTTON, window_, config::ID_VIEWER_LATEST);
+        date_picker_ = create_control(DATETIMEPICK_CLASS, L"", DTS_SHORTDATEFORMAT, window_, config::ID_VIEWER_DATE);
+        create_control(L"BUTTON", L"Go to date", BS_PUSHBUTTON, window_, config::ID_VIEWER_GO);
+        status_ = create_control(L"STATIC", L"", SS_LEFT | SS_CENTERIMAGE, window_, 0);
+        list_ = create_control(L"LISTBOX", L"", WS_BORDER | WS_VSCROLL | LBS_NOINTEGRALHEIGHT,
+            window_, config::ID_VIEWER_LIST);
+    }
+
+    void log_viewer::layout(int width, int height) {
+        const int margin = 8;
+        const int row_height = 26;
+
+        MoveWindow(GetDlgItem(window_, config::ID_VIEWER_OLDER), margin, margin, 80, row_height, TRUE);
+        MoveWindow(GetDlgItem(window_, config::ID_VIEWER_NEWER), margin + 88, margin, 80, row_height, TRUE);
+        MoveWindow(GetDlgItem(window_, config::ID_VIEWER_LATEST), margin + 176, margin, 80, row_height, TRUE);
+        MoveWindow(date_picker_, margin + 272, margin, 120, row_height, TRUE);
+        MoveWindow(GetDlgItem(window_, config::ID_VIEWER_GO), margin + 400, margin, 80, row_height, TRUE);
+        MoveWindow(status_, margin + 496, margin, width - margin * 2 - 496, row_height, TRUE);
+
+        int list_top = margin * 2 + row_height;
+        MoveWindow(list_, margin, list_top, width - margin * 2, height - list_top - margin, TRUE);
+    }
+
+    void log_viewer::show_lines(const std::vector<std::string>& lines, const std::wstring& status) {
+        SendMessage(list_, WM_SETREDRAW, FALSE, 0);
+        SendMessage(list_, LB_RESETCONTENT, 0, 0);
+        for (const auto& line : lines) {
+            std::wstring text(line.begin(), line.end());
+            SendMessage(list_, LB_ADDSTRING, 0, reinterpret_cast<LPARAM>(text.c_str()));
+        }
+        if (following_end_ && !lines.empty()) {
+            SendMessage(list_, LB_SETTOPINDEX, lines.size() - 1, 0);
+        }
+        SendMessage(list_, WM_SETREDRAW, TRUE, 0);
+        InvalidateRect(list_, nullptr, TRUE);
+        SetWindowText(status_, status.c_str());
+    }
+
+    void log_viewer::show_page(std::uint64_t first_line) {
+        first_line_ = first_line;
+        auto lines = pager_.read_lines(first_line, config::LOG_VIEWER_PAGE_LINES);
+        show_lines(lines, range_status(first_line, lines.size(), pager_.line_count()));
+    }
+
+    void log_viewer::show_latest() {
+        following_end_ = true;
+        auto lines = pager_.read_latest(config::LOG_VIEWER_PAGE_LINES);
+
+        // line numbers are only known once the index is complete
+        if (!pager_.complete()) {
+            show_lines(lines, lines.empty() ? L"No entries"
+                : L"Latest " + std::to_wstring(lines.size()) + L" entries, indexing older ones");
+            return;
+        }
+
+        std::uint64_t total = pager_.line_count();
+        first_line_ = total > lines.size() ? total - lines.size() : 0;
+        show_lines(lines, range_status(first_line_, lines.size(), total));
+    }
+
+    void log_viewer::follow_end() {
+        // only pull in new entries while the newest page is shown, and leave
+        // an unfinished index to index_step
+        if (!following_end_ || !pager_.complete()) return;
+
+        if (pager_.refresh(config::LOG_PAGER_INDEX_STEP)) {
+            show_latest();
+            if (!pager_.complete()) {
+                SetTimer(window_, config::TIMER_ID_VIEWER_INDEX, config::LOG_VIEWER_INDEX_MS, nullptr);
+            }
+        }
+    }
+
+    void log_viewer::index_step() {
+        pager_.refresh(config::LOG_PAGER_INDEX_STEP);
+        if (!pager_.complete()) return;
+
+        KillTimer(window_, config::TIMER_ID_VIEWER_INDEX);
+        if (following_end_) {
+            show_latest();
+        }
+    }
+
+    void log_viewer::finish_index() {
+        // paging needs line numbers, index the rest now if the steps are not done
+        if (pager_.complete()) return;
+
+        pager_.refresh();
+        KillTimer(window_, config::TIMER_ID_VIEWER_INDEX);
+        std::uint64_t total = pager_.line_count();
+        first_line_ = total > config::LOG_VIEWER_PAGE_LINES ? total - config::LOG_VIEWER_PAGE_LINES : 0;
+    }
+
+    void log_viewer::handle_command(WORD command_id) {
+        switch (command_id) {
+        case config::ID_VIEWER_OLDER:
+            finish_index();
+            following_end_ = false;
+            show_page(first_line_ > config::LOG_VIEWER_PAGE_LINES ? first_line_ - config::LOG_VIEWER_PAGE_LINES : 0);
+            break;
+        case config::ID_VIEWER_NEWER:
+            finish_index();
+            if (first_line_ + config::LOG_VIEWER_PAGE_LINES * 2 >= pager_.line_count()) {
+                show_latest();
+            }
+            else {
+                show_page(first_line_ + config::LOG_VIEWER_PAGE_LINES);
+            }
+            break;
+        case config::ID_VIEWER_LATEST:
+            show_latest();
+            break;
+        case config::ID_VIEWER_GO: {
+            SYSTEMTIME date{};
+            if (DateTime_GetSystemtime(date_picker_, &date) == GDT_VALID) {
+                finish_index();
+                pager_.refresh();
+                std::uint64_t first_line = pager_.find_day(time_utils::day_number(date.wYear, date.wMonth, date.wDay));
+
+                // nothing logged since that day
+                if (first_line + config::LOG_VIEWER_PAGE_LINES >= pager_.line_count()) {
+                    show_latest();
+                }
+                else {
+                    following_end_ = false;
+                    show_page(first_line);
+                }
+            }
+            break;
+        }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "types.h"
+#include "log_pager.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace time_tracker {
+    // window that pages through a log, opened at the most recent entries. the pager
+    // is shared and outlives the window, so reopening a log only indexes new lines
+    class log_viewer {
+    private:
+        HWND window_{ nullptr };
+        HWND list_{ nullptr };
+        HWND date_picker_{ nullptr };
+        HWND status_{ nullptr };
+
+        log_pager& pager_;
+        std::uint64_t first_line_{ 0 };
+        bool following_end_{ true };  // keep showing new entries as they are logged
+
+        explicit log_viewer(log_pager& pager);
+
+        static LRESULT CALLBACK window_proc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam);
+
+        void create_controls();
+        void layout(int width, int height);
+        void show_lines(const std::vector<std::string>& lines, const std::wstring& status);
+        void show_page(std::uint64_t first_line);
+        void show_latest();
+        void follow_end();
+        void index_step();
+        void finish_index();
+        void handle_command(WORD command_id);
+
+    public:
+        // the window owns the viewer and deletes it when closed, the pager must
+        // outlive it (the logger keeps one per log)
+        static void show(log_pager& pager, const std::wstring& title);
+    };
+}
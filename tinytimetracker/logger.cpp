@@ -1,38 +1,83 @@
 #include "logger.h"
 #include "time_utils.h"
 #include "config.h"
+#include "log_viewer.h"
+#include "alloc_tracking.h"
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <vector>
 
 namespace time_tracker {
+    namespace {
+        // append one line without going through iostreams, so logging does not allocate.
+        // lines end in \r\n like the text-mode streams used for the other logs.
+        void append_line(const std::string& path, const char* line, int length) {
+            if (length <= 0) return;
+
+            HANDLE file = CreateFileA(path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) return;
+
+            DWORD written = 0;
+            WriteFile(file, line, static_cast<DWORD>(length), &written, nullptr);
+            CloseHandle(file);
+        }
+    }
+
     logger::logger()
-        : time_log_path_(config::TIME_LOG_FILE)
-        , weekly_log_path_(config::WEEKLY_LOG_FILE)
-        , session_log_path_(config::SESSION_LOG_FILE) {
+        : logger(config::TIME_LOG_FILE, config::WEEKLY_LOG_FILE, config::SESSION_LOG_FILE) {
+        if (config::SESSION_JOURNAL_ENABLED) {
+            // falls back to the text session log if the journal cannot be mapped
+            session_journal_.open(config::SESSION_JOURNAL_FILE, config::SESSION_JOURNAL_CAPACITY);
+        }
+    }
+
+    logger::logger(const std::string& time_log_path, const std::string& weekly_log_path,
+        const std::string& session_log_path)
+        : time_log_path_(time_log_path)
+        , weekly_log_path_(weekly_log_path)
+        , session_log_path_(session_log_path)
+        , time_log_pager_(time_log_path, true)
+        , weekly_log_pager_(weekly_log_path, false)  // rewritten on every clock out
+        , session_log_pager_(session_log_path, true)
+        , session_export_pager_(config::SESSION_JOURNAL_EXPORT_FILE, false) {
     }
 
-    void logger::log_time_entry(const std::string& action, bool is_automatic) {
+    void logger::log_time_entry(const char* action, bool is_automatic) {
+        ZERO_ALLOC_SCOPE("log append");
         std::lock_guard<std::mutex> lock(log_mutex_);
 
-        std::ofstream log_file(time_log_path_, std::ios::app);
-        if (log_file.is_open()) {
-            std::string prefix = is_automatic ? "[AUTO] " : "";
-            log_file << time_utils::get_current_timestamp() << " - " << prefix << action << "\n";
-            log_file.close();
-        }
+        time_entry entry(action, is_automatic);
+        char timestamp[time_utils::FORMAT_BUFFER_SIZE];
+        time_utils::format_timestamp(entry.timestamp, timestamp, sizeof(timestamp));
+
+        char line[time_utils::FORMAT_BUFFER_SIZE + time_entry::ACTION_SIZE + 16];
+        int length = std::snprintf(line, sizeof(line), "%s - %s%s\r\n",
+            timestamp, entry.is_automatic ? "[AUTO] " : "", entry.action);
+        append_line(time_log_path_, line, std::min(length, static_cast<int>(sizeof(line)) - 1));
     }
 
-    void logger::log_session_event(const std::string& action) {
+    void logger::log_session_event(const char* action) {
+        ZERO_ALLOC_SCOPE("log append");
         std::lock_guard<std::mutex> lock(log_mutex_);
 
-        std::ofstream log_file(session_log_path_, std::ios::app);
-        if (log_file.is_open()) {
-            log_file << time_utils::get_current_timestamp() << " - " << action << "\n";
-            log_file.close();
+        auto now = std::chrono::system_clock::now();
+        if (session_journal_.is_open()) {
+            session_journal_.append(now, action);
+            return;
         }
+
+        char timestamp[time_utils::FORMAT_BUFFER_SIZE];
+        time_utils::format_timestamp(now, timestamp, sizeof(timestamp));
+
+        char line[time_utils::FORMAT_BUFFER_SIZE + time_entry::ACTION_SIZE + 16];
+        int length = std::snprintf(line, sizeof(line), "%s - %s\r\n", timestamp, action);
+        append_line(session_log_path_, line, std::min(length, static_cast<int>(sizeof(line)) - 1));
     }
 
     void logger::update_weekly_hours(std::chrono::system_clock::duration work_duration) {
+        ALLOC_SCOPE("weekly hours update");
         std::lock_guard<std::mutex> lock(log_mutex_);
 
         std::string today = time_utils::get_date_string();
@@ -46,6 +91,13 @@ namespace time_tracker {
 
         while (std::getline(read_file, line)) {
             if (line.find(today) == 0) {
+                // a day can have several sessions, add to what the earlier ones logged
+                int day = 0;
+                std::chrono::minutes logged{ 0 };
+                if (time_utils::parse_weekly_line(line.data(), line.size(), day, logged)) {
+                    work_duration += logged;
+                }
+
                 found_today = true;
                 lines.push_back(today + " - " + time_utils::format_duration(work_duration));
             }
@@ -68,14 +120,26 @@ namespace time_tracker {
     }
 
     void logger::open_time_log() {
-        ShellExecuteA(nullptr, "open", time_log_path_.c_str(), nullptr, nullptr, SW_SHOWNORMAL);
+        log_viewer::show(time_log_pager_, L"Daily Log");
     }
 
     void logger::open_weekly_log() {
-        ShellExecuteA(nullptr, "open", weekly_log_path_.c_str(), nullptr, nullptr, SW_SHOWNORMAL);
+        log_viewer::show(weekly_log_pager_, L"Weekly Hours");
     }
 
     void logger::open_session_log() {
-        ShellExecuteA(nullptr, "open", session_log_path_.c_str(), nullptr, nullptr, SW_SHOWNORMAL);
+        if (session_journal_.is_open()) {
+            // export the journal in time order and show that instead
+            {
+                std::lock_guard<std::mutex> lock(log_mutex_);
+                std::ofstream export_file(config::SESSION_JOURNAL_EXPORT_FILE);
+                session_journal_.dump(export_file);
+            }
+
+            log_viewer::show(session_export_pager_, L"Session Log");
+            return;
+        }
+
+        log_viewer::show(session_log_pager_, L"Session Log");
     }
 }
@@ -1,5 +1,7 @@
 #pragma once
 #include "types.h"
+#include "session_journal.h"
+#include "log_pager.h"
 #include <mutex>
 #include <string>
 
@@ -10,12 +12,22 @@ namespace time_tracker {
         std::string time_log_path_;
         std::string weekly_log_path_;
         std::string session_log_path_;
+        session_journal session_journal_;
+
+        // one per log for the process lifetime, so reopening a viewer only indexes new lines
+        log_pager time_log_pager_;
+        log_pager weekly_log_pager_;
+        log_pager session_log_pager_;
+        log_pager session_export_pager_;
 
     public:
         logger();
+        // explicit log files and no session journal, e.g. for scratch logs
+        logger(const std::string& time_log_path, const std::string& weekly_log_path,
+            const std::string& session_log_path);
 
-        void log_time_entry(const std::string& action, bool is_automatic = false);
-        void log_session_event(const std::string& action);
+        void log_time_entry(const char* action, bool is_automatic = false);
+        void log_session_event(const char* action);
         void update_weekly_hours(std::chrono::system_clock::duration work_duration);
 
         void open_time_log();
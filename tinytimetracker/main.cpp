@@ -4,50 +4,17 @@
 #include "types.h"
 #include "time_utils.h"
 #include "logger.h"
+#include "work_calendar.h"
+#include "menu_info.h"
+#include "cli.h"
+#include "alloc_tracking.h"
+#include <cstdio>
+#ifdef TIME_TRACKER_ALLOC_TRACKING
+#include <fstream>
+#endif
 
 using namespace time_tracker;
 
-// menu info helper for dynamic menu text
-class menu_info {
-public:
-    static std::wstring working_time_text;
-    static std::wstring next_break_text;
-    static std::wstring remaining_text;
-    static std::wstring status_text;
-
-    static void update_working_time(const std::string& time_str) {
-        working_time_text = L"⏰ Working: " + std::wstring(time_str.begin(), time_str.end());
-    }
-
-    static void update_next_break(const std::string& time_str) {
-        next_break_text = L"☕ Next Break: " + std::wstring(time_str.begin(), time_str.end());
-    }
-
-    static void update_remaining_time(const std::string& time_str) {
-        remaining_text = L"⏳ Remaining: " + std::wstring(time_str.begin(), time_str.end());
-    }
-
-    static void update_status(work_state state) {
-        switch (state) {
-        case work_state::clocked_in:
-            status_text = L"🟢 Status: Working";
-            break;
-        case work_state::on_break:
-            status_text = L"🟡 Status: On Break";
-            break;
-        default:
-            status_text = L"🔴 Status: Clocked Out";
-            break;
-        }
-    }
-};
-
-// static member definitions
-std::wstring menu_info::working_time_text = L"⏰ Working: 00:00:00";
-std::wstring menu_info::next_break_text = L"☕ Next Break: --:--:--";
-std::wstring menu_info::remaining_text = L"⏳ Remaining: 08:00:00";
-std::wstring menu_info::status_text = L"🔴 Status: Clocked Out";
-
 class time_tracker_app {
 private:
     HWND main_window_{ nullptr };
@@ -58,12 +25,13 @@ private:
     std::chrono::system_clock::time_point break_start_time_{};
 
     logger logger_;
+    work_calendar calendar_{ config::CALENDAR_FIRST_YEAR, config::CALENDAR_LAST_YEAR };
 
     bool first_break_taken_{ false };
     bool second_break_taken_{ false };
 
     void update_tray_tooltip() {
-        std::wstring tooltip;
+        const wchar_t* tooltip;
         switch (current_state_) {
         case work_state::clocked_in:
             tooltip = L"Working";
@@ -76,7 +44,7 @@ private:
             break;
         }
 
-        wcscpy_s(notify_icon_data_.szTip, sizeof(notify_icon_data_.szTip) / sizeof(WCHAR), tooltip.c_str());
+        wcscpy_s(notify_icon_data_.szTip, sizeof(notify_icon_data_.szTip) / sizeof(WCHAR), tooltip);
         Shell_NotifyIcon(NIM_MODIFY, &notify_icon_data_);
     }
 
@@ -87,12 +55,13 @@ private:
         HMENU context_menu = CreatePopupMenu();
 
         // add status info at top (grayed out, non-clickable)
-        AppendMenu(context_menu, MF_STRING | MF_GRAYED, config::ID_INFO_STATUS, menu_info::status_text.c_str());
+        AppendMenu(context_menu, MF_STRING | MF_GRAYED, config::ID_INFO_STATUS, menu_info::status_text);
+        AppendMenu(context_menu, MF_STRING | MF_GRAYED, config::ID_INFO_BALANCE, menu_info::balance_text);
 
         if (current_state_ != work_state::clocked_out) {
-            AppendMenu(context_menu, MF_STRING | MF_GRAYED, config::ID_INFO_WORKING_TIME, menu_info::working_time_text.c_str());
-            AppendMenu(context_menu, MF_STRING | MF_GRAYED, config::ID_INFO_NEXT_BREAK, menu_info::next_break_text.c_str());
-            AppendMenu(context_menu, MF_STRING | MF_GRAYED, config::ID_INFO_REMAINING, menu_info::remaining_text.c_str());
+            AppendMenu(context_menu, MF_STRING | MF_GRAYED, config::ID_INFO_WORKING_TIME, menu_info::working_time_text);
+            AppendMenu(context_menu, MF_STRING | MF_GRAYED, config::ID_INFO_NEXT_BREAK, menu_info::next_break_text);
+            AppendMenu(context_menu, MF_STRING | MF_GRAYED, config::ID_INFO_REMAINING, menu_info::remaining_text);
         }
 
         AppendMenu(context_menu, MF_SEPARATOR, 0, nullptr);
@@ -154,13 +123,21 @@ private:
         auto required_breaks = time_utils::calculate_required_breaks(work_duration);
         work_duration -= required_breaks;  // subtract required breaks from work time
 
+        char duration_text[time_utils::FORMAT_BUFFER_SIZE];
+        char action[time_entry::ACTION_SIZE];
+
         if (required_breaks > std::chrono::minutes(0)) {
-            logger_.log_time_entry("AUTO BREAKS ADDED: " + time_utils::format_duration(required_breaks), true);
+            time_utils::format_duration(required_breaks, duration_text, sizeof(duration_text));
+            std::snprintf(action, sizeof(action), "AUTO BREAKS ADDED: %s", duration_text);
+            logger_.log_time_entry(action, true);
         }
 
         current_state_ = work_state::clocked_out;
-        logger_.log_time_entry("CLOCK OUT - Net Work Time: " + time_utils::format_duration(work_duration), is_automatic);
+        time_utils::format_duration(work_duration, duration_text, sizeof(duration_text));
+        std::snprintf(action, sizeof(action), "CLOCK OUT - Net Work Time: %s", duration_text);
+        logger_.log_time_entry(action, is_automatic);
         logger_.update_weekly_hours(work_duration);
+        update_overtime_balance();
         update_tray_tooltip();
         update_menu_info();
 
@@ -199,7 +176,12 @@ private:
         auto break_duration = now - break_start_time_;
 
         current_state_ = work_state::clocked_in;
-        logger_.log_time_entry("BREAK END - Duration: " + time_utils::format_duration(break_duration));
+
+        char duration_text[time_utils::FORMAT_BUFFER_SIZE];
+        char action[time_entry::ACTION_SIZE];
+        time_utils::format_duration(break_duration, duration_text, sizeof(duration_text));
+        std::snprintf(action, sizeof(action), "BREAK END - Duration: %s", duration_text);
+        logger_.log_time_entry(action);
         update_tray_tooltip();
         update_menu_info();
 
@@ -244,55 +226,14 @@ private:
         }
     }
 
-    void update_menu_info() {
-        menu_info::update_status(current_state_);
-
-        if (current_state_ == work_state::clocked_out) {
-            menu_info::update_working_time("00:00:00");
-            menu_info::update_next_break("--:--:--");
-            menu_info::update_remaining_time("08:00:00");
-            return;
-        }
-
-        auto now = std::chrono::system_clock::now();
-        auto worked = now - clock_in_time_;
-
-        // current working time (including breaks)
-        if (current_state_ == work_state::on_break) {
-            auto break_time = now - break_start_time_;
-            auto net_worked = worked - break_time;
-            menu_info::update_working_time(time_utils::format_time_countdown(net_worked));
-        }
-        else {
-            menu_info::update_working_time(time_utils::format_time_countdown(worked));
-        }
-
-        // next break countdown
-        std::chrono::system_clock::duration time_to_next_break;
-        if (!first_break_taken_ && worked < std::chrono::milliseconds(config::FIRST_BREAK_AFTER_MS)) {
-            time_to_next_break = std::chrono::milliseconds(config::FIRST_BREAK_AFTER_MS) - worked;
-            menu_info::update_next_break(time_utils::format_time_countdown(time_to_next_break));
-        }
-        else if (!second_break_taken_ && worked < std::chrono::milliseconds(config::SECOND_BREAK_AFTER_MS)) {
-            time_to_next_break = std::chrono::milliseconds(config::SECOND_BREAK_AFTER_MS) - worked;
-            menu_info::update_next_break(time_utils::format_time_countdown(time_to_next_break));
-        }
-        else {
-            menu_info::update_next_break("No more breaks");
-        }
-
-        // remaining work time (target 8 hours minus worked time plus required breaks)
-        auto target_work = std::chrono::hours(8);
-        auto required_breaks = time_utils::calculate_required_breaks(worked);
-        auto net_worked = worked - required_breaks;
-        auto remaining = target_work - net_worked;
+    void update_overtime_balance() {
+        auto balance = compute_overtime_balance(calendar_, config::WEEKLY_LOG_FILE);
+        menu_info::update_balance(time_utils::format_balance(balance.balance()).c_str());
+    }
 
-        if (remaining.count() > 0) {
-            menu_info::update_remaining_time(time_utils::format_time_countdown(remaining));
-        }
-        else {
-            menu_info::update_remaining_time("00:00:00 (Overtime!)");
-        }
+    void update_menu_info() {
+        refresh_menu_info({ current_state_, clock_in_time_, break_start_time_,
+            first_break_taken_, second_break_taken_ }, calendar_);
     }
 
 public:
@@ -318,8 +259,12 @@ public:
         // set initial tooltip
         wcscpy_s(notify_icon_data_.szTip, sizeof(notify_icon_data_.szTip) / sizeof(WCHAR), L"Time Tracker - Clocked OUT");
 
+        // load working days, holidays and absences (defaults to monday to friday, 8 hours)
+        calendar_.load(config::CALENDAR_FILE);
+
         // initialize menu info
-        menu_info::update_status(work_state::clocked_out);
+        update_overtime_balance();
+        update_menu_info();
 
         // add icon to system tray
         return Shell_NotifyIcon(NIM_ADD, &notify_icon_data_);
@@ -469,6 +414,12 @@ LRESULT CALLBACK window_proc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam)
 
 // application entry point
 int WINAPI WinMain(HINSTANCE instance, HINSTANCE, LPSTR, int) {
+    // command line tools run without the tray icon
+    int exit_code = 0;
+    if (cli::run(exit_code)) {
+        return exit_code;
+    }
+
     // register window class
     const wchar_t* class_name = L"TimeTrackerWindow";
 
@@ -513,5 +464,11 @@ int WINAPI WinMain(HINSTANCE instance, HINSTANCE, LPSTR, int) {
         DispatchMessage(&msg);
     }
 
+#ifdef TIME_TRACKER_ALLOC_TRACKING
+    // per-operation allocation counters of this run
+    std::ofstream alloc_report(config::ALLOC_REPORT_FILE);
+    alloc_tracking::write_report(alloc_report);
+#endif
+
     return static_cast<int>(msg.wParam);
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+﻿#include "menu_info.h"
+#include "work_calendar.h"
+#include "time_utils.h"
+#include "config.h"
+#include "alloc_tracking.h"
+#include <cwchar>
+
+namespace time_tracker {
+    wchar_t menu_info::working_time_text[menu_info::TEXT_SIZE] = L"⏰ Working: 00:00:00";
+    wchar_t menu_info::next_break_text[menu_info::TEXT_SIZE] = L"☕ Next Break: --:--:--";
+    wchar_t menu_info::remaining_text[menu_info::TEXT_SIZE] = L"⏳ Remaining: 08:00:00";
+    wchar_t menu_info::status_text[menu_info::TEXT_SIZE] = L"🔴 Status: Clocked Out";
+    wchar_t menu_info::balance_text[menu_info::TEXT_SIZE] = L"📈 Balance: +0h 0m";
+
+    void menu_info::update_working_time(const char* time_str) {
+        swprintf(working_time_text, TEXT_SIZE, L"⏰ Working: %hs", time_str);
+    }
+
+    void menu_info::update_next_break(const char* time_str) {
+        swprintf(next_break_text, TEXT_SIZE, L"☕ Next Break: %hs", time_str);
+    }
+
+    void menu_info::update_remaining_time(const char* time_str) {
+        swprintf(remaining_text, TEXT_SIZE, L"⏳ Remaining: %hs", time_str);
+    }
+
+    void menu_info::update_balance(const char* balance_str) {
+        swprintf(balance_text, TEXT_SIZE, L"📈 Balance: %hs", balance_str);
+    }
+
+    void menu_info::update_status(work_state state) {
+        switch (state) {
+        case work_state::clocked_in:
+            wcscpy_s(status_text, L"🟢 Status: Working");
+            break;
+        case work_state::on_break:
+            wcscpy_s(status_text, L"🟡 Status: On Break");
+            break;
+        default:
+            wcscpy_s(status_text, L"🔴 Status: Clocked Out");
+            break;
+        }
+    }
+
+    void refresh_menu_info(const tracker_status& status, const work_calendar& calendar) {
+        ZERO_ALLOC_SCOPE("status update");
+        char text[time_utils::FORMAT_BUFFER_SIZE];
+
+        menu_info::update_status(status.state);
+
+        // today's target from the calendar (0 on weekends, holidays and absences)
+        auto target_work = calendar.expected_on(work_calendar::today());
+
+        if (status.state == work_state::clocked_out) {
+            menu_info::update_working_time("00:00:00");
+            menu_info::update_next_break("--:--:--");
+            time_utils::format_time_countdown(target_work, text, sizeof(text));
+            menu_info::update_remaining_time(text);
+            return;
+        }
+
+        auto now = std::chrono::system_clock::now();
+        auto worked = now - status.clock_in_time;
+
+        // current working time (including breaks)
+        if (status.state == work_state::on_break) {
+            auto break_time = now - status.break_start_time;
+            auto net_worked = worked - break_time;
+            time_utils::format_time_countdown(net_worked, text, sizeof(text));
+            menu_info::update_working_time(text);
+        }
+        else {
+            time_utils::format_time_countdown(worked, text, sizeof(text));
+            menu_info::update_working_time(text);
+        }
+
+        // next break countdown
+        std::chrono::system_clock::duration time_to_next_break;
+        if (!status.first_break_taken && worked < std::chrono::milliseconds(config::FIRST_BREAK_AFTER_MS)) {
+            time_to_next_break = std::chrono::milliseconds(config::FIRST_BREAK_AFTER_MS) - worked;
+            time_utils::format_time_countdown(time_to_next_break, text, sizeof(text));
+            menu_info::update_next_break(text);
+        }
+        else if (!status.second_break_taken && worked < std::chrono::milliseconds(config::SECOND_BREAK_AFTER_MS)) {
+            time_to_next_break = std::chrono::milliseconds(config::SECOND_BREAK_AFTER_MS) - worked;
+            time_utils::format_time_countdown(time_to_next_break, text, sizeof(text));
+            menu_info::update_next_break(text);
+        }
+        else {
+            menu_info::update_next_break("No more breaks");
+        }
+
+        // remaining work time (daily target minus worked time plus required breaks)
+        auto required_breaks = time_utils::calculate_required_breaks(worked);
+        auto net_worked = worked - required_breaks;
+        auto remaining = target_work - net_worked;
+
+        if (remaining.count() > 0) {
+            time_utils::format_time_countdown(remaining, text, sizeof(text));
+            menu_info::update_remaining_time(text);
+        }
+        else {
+            menu_info::update_remaining_time("00:00:00 (Overtime!)");
+        }
+    }
+}
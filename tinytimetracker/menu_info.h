@@ -0,0 +1,38 @@
+#pragma once
+#include "types.h"
+
+namespace time_tracker {
+    class work_calendar;
+
+    // menu info helper for dynamic menu text
+    // (fixed buffers, so the per-second status update does not allocate)
+    class menu_info {
+    public:
+        static constexpr size_t TEXT_SIZE = 64;
+
+        static wchar_t working_time_text[TEXT_SIZE];
+        static wchar_t next_break_text[TEXT_SIZE];
+        static wchar_t remaining_text[TEXT_SIZE];
+        static wchar_t status_text[TEXT_SIZE];
+        static wchar_t balance_text[TEXT_SIZE];
+
+        static void update_working_time(const char* time_str);
+        static void update_next_break(const char* time_str);
+        static void update_remaining_time(const char* time_str);
+        static void update_balance(const char* balance_str);
+        static void update_status(work_state state);
+    };
+
+    // the tracker state the status texts are computed from
+    struct tracker_status {
+        work_state state;
+        std::chrono::system_clock::time_point clock_in_time;
+        std::chrono::system_clock::time_point break_start_time;
+        bool first_break_taken;
+        bool second_break_taken;
+    };
+
+    // refresh the status, working time, next break and remaining time texts.
+    // runs every second, so it must not allocate
+    void refresh_menu_info(const tracker_status& status, const work_calendar& calendar);
+}
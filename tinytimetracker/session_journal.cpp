@@ -0,0 +1,205 @@
+#include "session_journal.h"
+#include "time_utils.h"
+#include <cstring>
+
+namespace time_tracker {
+    namespace {
+        constexpr std::uint32_t JOURNAL_MAGIC = 0x4A535454;  // "TTSJ"
+        constexpr std::uint32_t JOURNAL_VERSION = 1;
+    }
+
+    session_journal::~session_journal() {
+        close();
+    }
+
+    bool session_journal::open(const std::string& path, std::uint32_t capacity) {
+        close();
+        if (capacity == 0) return false;
+
+        file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+            nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER file_size{};
+        GetFileSizeEx(file_, &file_size);
+
+        // reuse an existing journal if its layout matches
+        std::vector<record> kept;
+        if (file_size.QuadPart >= static_cast<LONGLONG>(sizeof(header))) {
+            auto existing_capacity = static_cast<std::uint32_t>(
+                (file_size.QuadPart - sizeof(header)) / sizeof(record));
+
+            if (existing_capacity > 0 && map_file(existing_capacity, true)) {
+                bool valid = header_->magic == JOURNAL_MAGIC
+                    && header_->version == JOURNAL_VERSION
+                    && header_->record_size == sizeof(record)
+                    && header_->capacity == existing_capacity
+                    && header_->head < existing_capacity
+                    && header_->tail < existing_capacity;
+
+                if (valid && existing_capacity == capacity) {
+                    return true;
+                }
+                if (valid) {
+                    kept = read_all();
+                }
+
+                UnmapViewOfFile(header_);
+                CloseHandle(mapping_);
+                header_ = nullptr;
+                records_ = nullptr;
+                mapping_ = nullptr;
+            }
+        }
+
+        // (re)create the file at the requested size
+        LARGE_INTEGER new_size{};
+        new_size.QuadPart = sizeof(header) + static_cast<LONGLONG>(capacity) * sizeof(record);
+        if (!SetFilePointerEx(file_, new_size, nullptr, FILE_BEGIN) || !SetEndOfFile(file_)) {
+            close();
+            return false;
+        }
+
+        if (!map_file(capacity, true)) {
+            close();
+            return false;
+        }
+
+        reset(capacity);
+
+        // carry over the newest records when the capacity changed
+        std::size_t first = kept.size() > capacity ? kept.size() - capacity : 0;
+        for (std::size_t i = first; i < kept.size(); ++i) {
+            std::memcpy(&records_[header_->head], &kept[i], sizeof(record));
+            header_->head = (header_->head + 1) % capacity;
+            if (header_->head == 0) {
+                ++header_->generation;
+            }
+        }
+        if (header_->generation > 0) {
+            header_->tail = header_->head;
+        }
+
+        return true;
+    }
+
+    bool session_journal::open_read_only(const std::string& path) {
+        close();
+
+        // the tracker keeps the journal open for writing, so writers must be shared
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER file_size{};
+        GetFileSizeEx(file_, &file_size);
+
+        std::uint32_t capacity = 0;
+        if (file_size.QuadPart >= static_cast<LONGLONG>(sizeof(header))) {
+            capacity = static_cast<std::uint32_t>((file_size.QuadPart - sizeof(header)) / sizeof(record));
+        }
+
+        bool valid = capacity > 0 && map_file(capacity, false)
+            && header_->magic == JOURNAL_MAGIC
+            && header_->version == JOURNAL_VERSION
+            && header_->record_size == sizeof(record)
+            && header_->capacity == capacity
+            && header_->head < capacity
+            && header_->tail < capacity;
+        if (!valid) {
+            close();
+            return false;
+        }
+
+        read_only_ = true;
+        return true;
+    }
+
+    bool session_journal::map_file(std::uint32_t capacity, bool writable) {
+        std::uint64_t size = sizeof(header) + static_cast<std::uint64_t>(capacity) * sizeof(record);
+
+        mapping_ = CreateFileMappingA(file_, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+            static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+        if (!mapping_) return false;
+
+        void* view = MapViewOfFile(mapping_, writable ? FILE_MAP_READ | FILE_MAP_WRITE : FILE_MAP_READ,
+            0, 0, static_cast<SIZE_T>(size));
+        if (!view) {
+            CloseHandle(mapping_);
+            mapping_ = nullptr;
+            return false;
+        }
+
+        header_ = static_cast<header*>(view);
+        records_ = reinterpret_cast<record*>(static_cast<char*>(view) + sizeof(header));
+        return true;
+    }
+
+    void session_journal::reset(std::uint32_t capacity) {
+        std::memset(header_, 0, sizeof(header));
+        header_->magic = JOURNAL_MAGIC;
+        header_->version = JOURNAL_VERSION;
+        header_->capacity = capacity;
+        header_->record_size = sizeof(record);
+    }
+
+    void session_journal::close() {
+        if (header_) {
+            UnmapViewOfFile(header_);
+            header_ = nullptr;
+            records_ = nullptr;
+        }
+        if (mapping_) {
+            CloseHandle(mapping_);
+            mapping_ = nullptr;
+        }
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+            file_ = INVALID_HANDLE_VALUE;
+        }
+        read_only_ = false;
+    }
+
+    void session_journal::append(std::chrono::system_clock::time_point timestamp, const char* action) {
+        if (!header_ || read_only_) return;
+
+        record entry{};
+        entry.timestamp = static_cast<std::int64_t>(std::chrono::system_clock::to_time_t(timestamp));
+        strncpy_s(entry.action, action, _TRUNCATE);
+
+        // write the record before publishing the new head
+        std::uint64_t head = header_->head;
+        std::memcpy(&records_[head], &entry, sizeof(record));
+
+        std::uint64_t next = (head + 1) % header_->capacity;
+        if (next == 0) {
+            ++header_->generation;
+        }
+        if (header_->generation > 0) {
+            header_->tail = next;  // ring is full, the next slot holds the oldest record
+        }
+        header_->head = next;
+    }
+
+    std::vector<session_journal::record> session_journal::read_all() const {
+        std::vector<record> result;
+        if (!header_) return result;
+
+        std::uint64_t capacity = header_->capacity;
+        std::uint64_t count = header_->generation > 0 ? capacity : header_->head;
+        std::uint64_t start = header_->generation > 0 ? header_->tail : 0;
+
+        result.reserve(static_cast<std::size_t>(count));
+        for (std::uint64_t i = 0; i < count; ++i) {
+            result.push_back(records_[(start + i) % capacity]);
+        }
+        return result;
+    }
+
+    void session_journal::dump(std::ostream& out) const {
+        for (const auto& entry : read_all()) {
+            auto timestamp = std::chrono::system_clock::from_time_t(static_cast<std::time_t>(entry.timestamp));
+            out << time_utils::format_timestamp(timestamp) << " - " << entry.action << "\n";
+        }
+    }
+}
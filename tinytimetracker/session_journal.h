@@ -0,0 +1,66 @@
+#pragma once
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace time_tracker {
+    // bounded session event log: a preallocated, memory-mapped ring of fixed-size
+    // records. once the ring is full the oldest record is overwritten.
+    class session_journal {
+    public:
+        static constexpr std::size_t ACTION_SIZE = 48;
+
+        struct record {
+            std::int64_t timestamp;     // seconds since epoch
+            char action[ACTION_SIZE];   // nul-terminated, truncated if longer
+        };
+
+    private:
+        struct header {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t capacity;     // number of record slots
+            std::uint32_t record_size;
+            std::uint64_t head;         // slot the next record is written to
+            std::uint64_t tail;         // slot of the oldest record
+            std::uint64_t generation;   // number of times the ring wrapped around
+        };
+
+        HANDLE file_{ INVALID_HANDLE_VALUE };
+        HANDLE mapping_{ nullptr };
+        header* header_{ nullptr };
+        record* records_{ nullptr };
+        bool read_only_{ false };
+
+        bool map_file(std::uint32_t capacity, bool writable);
+        void reset(std::uint32_t capacity);
+
+    public:
+        session_journal() = default;
+        ~session_journal();
+
+        session_journal(const session_journal&) = delete;
+        session_journal& operator=(const session_journal&) = delete;
+
+        // open or create the journal file with the given number of slots.
+        // an existing journal with a different capacity keeps its newest records.
+        bool open(const std::string& path, std::uint32_t capacity);
+
+        // open an existing journal for reading only, also while the tracker has it open.
+        // fails if the file is missing or not a journal
+        bool open_read_only(const std::string& path);
+        void close();
+        bool is_open() const { return header_ != nullptr; }
+
+        void append(std::chrono::system_clock::time_point timestamp, const char* action);
+
+        // records oldest first
+        std::vector<record> read_all() const;
+
+        // write "timestamp - action" lines oldest first, same format as the text logs
+        void dump(std::ostream& out) const;
+    };
+}
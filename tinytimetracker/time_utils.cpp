@@ -1,15 +1,26 @@
 #include "time_utils.h"
 #include "config.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 
 namespace time_tracker {
     namespace time_utils {
         std::string get_current_timestamp() {
-            auto now = std::chrono::system_clock::now();
-            auto time_t = std::chrono::system_clock::to_time_t(now);
+            return format_timestamp(std::chrono::system_clock::now());
+        }
 
-            std::stringstream ss;
-            ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-            return ss.str();
+        std::string format_timestamp(std::chrono::system_clock::time_point time_point) {
+            char buffer[FORMAT_BUFFER_SIZE];
+            format_timestamp(time_point, buffer, sizeof(buffer));
+            return buffer;
+        }
+
+        void format_timestamp(std::chrono::system_clock::time_point time_point, char* buffer, size_t size) {
+            auto time_t = std::chrono::system_clock::to_time_t(time_point);
+            if (std::strftime(buffer, size, "%Y-%m-%d %H:%M:%S", std::localtime(&time_t)) == 0 && size > 0) {
+                buffer[0] = '\0';
+            }
         }
 
         std::string get_date_string() {
@@ -31,24 +42,128 @@ namespace time_tracker {
         }
 
         std::string format_duration(std::chrono::system_clock::duration duration) {
+            char buffer[FORMAT_BUFFER_SIZE];
+            format_duration(duration, buffer, sizeof(buffer));
+            return buffer;
+        }
+
+        void format_duration(std::chrono::system_clock::duration duration, char* buffer, size_t size) {
             auto hours = std::chrono::duration_cast<std::chrono::hours>(duration);
             auto minutes = std::chrono::duration_cast<std::chrono::minutes>(duration - hours);
 
-            std::stringstream ss;
-            ss << hours.count() << "h " << minutes.count() << "m";
-            return ss.str();
+            std::snprintf(buffer, size, "%lldh %lldm",
+                static_cast<long long>(hours.count()), static_cast<long long>(minutes.count()));
         }
 
         std::string format_time_countdown(std::chrono::system_clock::duration duration) {
+            char buffer[FORMAT_BUFFER_SIZE];
+            format_time_countdown(duration, buffer, sizeof(buffer));
+            return buffer;
+        }
+
+        void format_time_countdown(std::chrono::system_clock::duration duration, char* buffer, size_t size) {
             auto hours = std::chrono::duration_cast<std::chrono::hours>(duration);
             auto minutes = std::chrono::duration_cast<std::chrono::minutes>(duration - hours);
             auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration - hours - minutes);
 
-            std::stringstream ss;
-            ss << std::setfill('0') << std::setw(2) << hours.count() << ":"
-                << std::setfill('0') << std::setw(2) << minutes.count() << ":"
-                << std::setfill('0') << std::setw(2) << seconds.count();
-            return ss.str();
+            std::snprintf(buffer, size, "%02lld:%02lld:%02lld", static_cast<long long>(hours.count()),
+                static_cast<long long>(minutes.count()), static_cast<long long>(seconds.count()));
+        }
+
+        std::string format_balance(std::chrono::system_clock::duration duration) {
+            if (duration.count() < 0) {
+                return "-" + format_duration(-duration);
+            }
+            return "+" + format_duration(duration);
+        }
+
+        int day_number(int year, int month, int day) {
+            // days from civil
+            year -= month <= 2 ? 1 : 0;
+            int era = (year >= 0 ? year : year - 399) / 400;
+            int year_of_era = year - era * 400;
+            int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+            int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+            return era * 146097 + day_of_era - 719468;
+        }
+
+        bool has_log_timestamp(const char* line, size_t length) {
+            static constexpr char pattern[] = "0000-00-00 00:00:00 - ";
+            if (length < LOG_PREFIX_LENGTH) return false;
+
+            for (size_t i = 0; i < LOG_PREFIX_LENGTH; ++i) {
+                if (pattern[i] == '0') {
+                    if (line[i] < '0' || line[i] > '9') return false;
+                }
+                else if (line[i] != pattern[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool parse_log_day(const char* line, size_t length, int& day) {
+            if (length < 10 || line[4] != '-' || line[7] != '-') return false;
+            for (int i : { 0, 1, 2, 3, 5, 6, 8, 9 }) {
+                if (line[i] < '0' || line[i] > '9') return false;
+            }
+
+            int year = (line[0] - '0') * 1000 + (line[1] - '0') * 100 + (line[2] - '0') * 10 + (line[3] - '0');
+            int month = (line[5] - '0') * 10 + (line[6] - '0');
+            int day_of_month = (line[8] - '0') * 10 + (line[9] - '0');
+            if (month < 1 || month > 12 || day_of_month < 1 || day_of_month > 31) return false;
+
+            day = day_number(year, month, day_of_month);
+            return true;
+        }
+
+        bool parse_duration(const char* text, const char* end, std::chrono::minutes& duration) {
+            const char units[] = { 'h', 'm' };
+            long long parts[] = { 0, 0 };
+
+            for (int i = 0; i < 2; ++i) {
+                if (i > 0) {
+                    if (text == end || *text != ' ') return false;
+                    ++text;
+                }
+
+                bool negative = text < end && *text == '-';
+                if (negative) ++text;
+
+                const char* number = text;
+                while (text < end && *text >= '0' && *text <= '9') {
+                    parts[i] = parts[i] * 10 + (*text - '0');
+                    ++text;
+                }
+                if (text == number || text == end || *text != units[i]) return false;
+                ++text;
+
+                if (negative) parts[i] = -parts[i];
+            }
+
+            duration = std::chrono::hours(parts[0]) + std::chrono::minutes(parts[1]);
+            return text == end;
+        }
+
+        bool parse_weekly_line(const char* line, size_t length, int& day, std::chrono::minutes& worked) {
+            const char* end = line + length;
+            return length > WEEKLY_PREFIX_LENGTH
+                && parse_log_day(line, length, day)
+                && std::memcmp(line + 10, " - ", 3) == 0
+                && parse_duration(line + WEEKLY_PREFIX_LENGTH, end, worked);
+        }
+
+        long long log_time_seconds(const char* line) {
+            auto number = [line](size_t first, size_t count) {
+                int value = 0;
+                for (size_t i = first; i < first + count; ++i) {
+                    value = value * 10 + (line[i] - '0');
+                }
+                return value;
+            };
+
+            long long day = day_number(number(0, 4), number(5, 2), number(8, 2));
+            return day * 86400 + number(11, 2) * 3600 + number(14, 2) * 60 + number(17, 2);
         }
 
         std::chrono::system_clock::duration calculate_required_breaks(
@@ -1,15 +1,47 @@
 #pragma once
 #include "types.h"
+#include <cstddef>
 #include <sstream>
 #include <iomanip>
 
 namespace time_tracker {
     namespace time_utils {
         std::string get_current_timestamp();
+        std::string format_timestamp(std::chrono::system_clock::time_point time_point);
         std::string get_date_string();
         std::string get_week_string();
         std::string format_duration(std::chrono::system_clock::duration duration);
         std::string format_time_countdown(std::chrono::system_clock::duration duration);
+        std::string format_balance(std::chrono::system_clock::duration duration);  // "+1h 30m" / "-0h 45m"
+
+        // allocation-free variants for hot paths, writing into a caller buffer
+        constexpr size_t FORMAT_BUFFER_SIZE = 32;
+        void format_timestamp(std::chrono::system_clock::time_point time_point, char* buffer, size_t size);
+        void format_duration(std::chrono::system_clock::duration duration, char* buffer, size_t size);
+        void format_time_countdown(std::chrono::system_clock::duration duration, char* buffer, size_t size);
+
+        // days since 1970-01-01 in the proleptic gregorian calendar
+        int day_number(int year, int month, int day);
+
+        // log lines start with "YYYY-MM-DD HH:MM:SS - "
+        constexpr size_t LOG_TIMESTAMP_LENGTH = 19;
+        constexpr size_t LOG_PREFIX_LENGTH = LOG_TIMESTAMP_LENGTH + 3;
+        bool has_log_timestamp(const char* line, size_t length);
+
+        // day number of the "YYYY-MM-DD" that starts time log and weekly log lines,
+        // false if the line does not start with a valid date
+        bool parse_log_day(const char* line, size_t length, int& day);
+
+        // "7h 45m" as written by format_duration (negative parts too), nothing may follow
+        bool parse_duration(const char* text, const char* end, std::chrono::minutes& duration);
+
+        // weekly log lines are "YYYY-MM-DD - 7h 45m", the day's net work time
+        constexpr size_t WEEKLY_PREFIX_LENGTH = 13;
+        bool parse_weekly_line(const char* line, size_t length, int& day, std::chrono::minutes& worked);
+
+        // seconds since 1970-01-01 of the timestamp at the start of a line that passed
+        // has_log_timestamp. log times are local, so only differences are meaningful
+        long long log_time_seconds(const char* line);
 
         // calculate required breaks based on work duration
         std::chrono::system_clock::duration calculate_required_breaks(
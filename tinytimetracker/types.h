@@ -1,6 +1,7 @@
 #pragma once
 #include "windows_includes.h"
 #include <chrono>
+#include <cstring>
 #include <string>
 
 namespace time_tracker {
@@ -11,12 +12,15 @@ namespace time_tracker {
     };
 
     struct time_entry {
+        static constexpr size_t ACTION_SIZE = 96;
+
         std::chrono::system_clock::time_point timestamp;
-        std::string action;
+        char action[ACTION_SIZE];  // fixed size so creating an entry does not allocate
         bool is_automatic;
 
-        time_entry(const std::string& act, bool auto_flag = false)
-            : timestamp(std::chrono::system_clock::now()), action(act), is_automatic(auto_flag) {
+        time_entry(const char* act, bool auto_flag = false)
+            : timestamp(std::chrono::system_clock::now()), action{}, is_automatic(auto_flag) {
+            strncpy_s(action, act, _TRUNCATE);
         }
     };
 
@@ -0,0 +1,345 @@
+#include "work_calendar.h"
+#include "time_utils.h"
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace time_tracker {
+    namespace {
+        int popcount(std::uint64_t bits) {
+#if defined(_MSC_VER) && defined(_M_X64)
+            return static_cast<int>(__popcnt64(bits));
+#else
+            bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+            bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+            bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return static_cast<int>((bits * 0x0101010101010101ULL) >> 56);
+#endif
+        }
+
+        // state bits for the holiday table
+        constexpr std::uint32_t state_bit(german_state state) {
+            return 1u << static_cast<int>(state);
+        }
+
+        // nationwide, includes german_state::none so these also apply without a state
+        constexpr std::uint32_t ALL_STATES = 0xFFFFFFFFu;
+
+        enum class holiday_kind {
+            fixed,          // month and day
+            easter,         // offset in days from easter sunday
+            repentance_day  // wednesday before november 23
+        };
+
+        struct holiday_rule {
+            holiday_kind kind;
+            int month;
+            int day;
+            std::uint32_t states;
+            int since_year;
+            int until_year;
+        };
+
+        // german public holidays, federal and per state
+        const holiday_rule GERMAN_HOLIDAYS[] = {
+            { holiday_kind::fixed, 1, 1, ALL_STATES, 0, 9999 },                 // neujahr
+            { holiday_kind::fixed, 1, 6, state_bit(german_state::bw) | state_bit(german_state::by)
+                | state_bit(german_state::st), 0, 9999 },                        // heilige drei koenige
+            { holiday_kind::fixed, 3, 8, state_bit(german_state::be), 2019, 9999 },  // frauentag
+            { holiday_kind::fixed, 3, 8, state_bit(german_state::mv), 2023, 9999 },
+            { holiday_kind::easter, 0, -2, ALL_STATES, 0, 9999 },               // karfreitag
+            { holiday_kind::easter, 0, 1, ALL_STATES, 0, 9999 },                // ostermontag
+            { holiday_kind::fixed, 5, 1, ALL_STATES, 0, 9999 },                 // tag der arbeit
+            { holiday_kind::easter, 0, 39, ALL_STATES, 0, 9999 },               // christi himmelfahrt
+            { holiday_kind::easter, 0, 50, ALL_STATES, 0, 9999 },               // pfingstmontag
+            { holiday_kind::easter, 0, 60, state_bit(german_state::bw) | state_bit(german_state::by)
+                | state_bit(german_state::he) | state_bit(german_state::nw) | state_bit(german_state::rp)
+                | state_bit(german_state::sl), 0, 9999 },                        // fronleichnam
+            { holiday_kind::fixed, 8, 15, state_bit(german_state::sl), 0, 9999 },   // mariae himmelfahrt
+            { holiday_kind::fixed, 9, 20, state_bit(german_state::th), 2019, 9999 },  // weltkindertag
+            { holiday_kind::fixed, 10, 3, ALL_STATES, 1990, 9999 },             // tag der deutschen einheit
+            { holiday_kind::fixed, 10, 31, state_bit(german_state::bb) | state_bit(german_state::mv)
+                | state_bit(german_state::sn) | state_bit(german_state::st)
+                | state_bit(german_state::th), 0, 9999 },                        // reformationstag
+            { holiday_kind::fixed, 10, 31, state_bit(german_state::hb) | state_bit(german_state::hh)
+                | state_bit(german_state::ni) | state_bit(german_state::sh), 2018, 9999 },
+            { holiday_kind::fixed, 10, 31, ALL_STATES, 2017, 2017 },            // reformation anniversary
+            { holiday_kind::fixed, 11, 1, state_bit(german_state::bw) | state_bit(german_state::by)
+                | state_bit(german_state::nw) | state_bit(german_state::rp)
+                | state_bit(german_state::sl), 0, 9999 },                        // allerheiligen
+            { holiday_kind::repentance_day, 11, 0, state_bit(german_state::sn), 1995, 9999 },  // buss- und bettag
+            { holiday_kind::fixed, 12, 25, ALL_STATES, 0, 9999 },               // 1. weihnachtstag
+            { holiday_kind::fixed, 12, 26, ALL_STATES, 0, 9999 },               // 2. weihnachtstag
+        };
+
+        const char* const STATE_CODES[] = {
+            "", "BW", "BY", "BE", "BB", "HB", "HH", "HE", "MV", "NI", "NW", "RP", "SL", "SN", "ST", "SH", "TH"
+        };
+
+        const char* const WEEKDAY_NAMES[] = { "mon", "tue", "wed", "thu", "fri", "sat", "sun" };
+
+        // anonymous gregorian algorithm
+        int easter_sunday(int year) {
+            int a = year % 19;
+            int b = year / 100;
+            int c = year % 100;
+            int d = b / 4;
+            int e = b % 4;
+            int f = (b + 8) / 25;
+            int g = (b - f + 1) / 3;
+            int h = (19 * a + b - d - g + 15) % 30;
+            int i = c / 4;
+            int k = c % 4;
+            int l = (32 + 2 * e + 2 * i - h - k) % 7;
+            int m = (a + 11 * h + 22 * l) / 451;
+            int month = (h + l - 7 * m + 114) / 31;
+            int day = ((h + l - 7 * m + 114) % 31) + 1;
+            return time_utils::day_number(year, month, day);
+        }
+
+        // bits of the inclusive day range [first, last] within word `index`
+        std::uint64_t range_mask(size_t index, int first, int last) {
+            int word_first = static_cast<int>(index * 64);
+            int low = std::max(first - word_first, 0);
+            int high = std::min(last - word_first, 63);
+            if (low > high) return 0;
+
+            std::uint64_t upper = high == 63 ? ~0ULL : (1ULL << (high + 1)) - 1;
+            return upper & ~((1ULL << low) - 1);
+        }
+    }
+
+    work_calendar::work_calendar(int first_year, int last_year)
+        : first_year_(first_year)
+        , last_year_(last_year)
+        , first_day_(time_utils::day_number(first_year, 1, 1))
+        , last_day_(time_utils::day_number(last_year, 12, 31)) {
+
+        // default: monday to friday, 8 hours
+        for (int i = 0; i < 7; ++i) {
+            weekday_minutes_[i] = i < 5 ? std::chrono::minutes(8 * 60) : std::chrono::minutes(0);
+        }
+
+        absences_.assign(word_count(), 0);
+        rebuild_holidays();
+        rebuild_working_days();
+    }
+
+    int work_calendar::today() {
+        auto time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::tm local = *std::localtime(&time_t);
+        return time_utils::day_number(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+    }
+
+    int work_calendar::weekday(int day) {
+        // 1970-01-01 was a thursday
+        return ((day % 7) + 7 + 3) % 7;
+    }
+
+    bool work_calendar::parse_date(const std::string& text, int& day) {
+        int year = 0, month = 0, day_of_month = 0;
+        char dash1 = 0, dash2 = 0;
+
+        std::istringstream ss(text);
+        ss >> year >> dash1 >> month >> dash2 >> day_of_month;
+        if (ss.fail() || dash1 != '-' || dash2 != '-') return false;
+        if (month < 1 || month > 12 || day_of_month < 1 || day_of_month > 31) return false;
+
+        day = time_utils::day_number(year, month, day_of_month);
+        return true;
+    }
+
+    size_t work_calendar::word_count() const {
+        return static_cast<size_t>(last_day_ - first_day_) / 64 + 1;
+    }
+
+    void work_calendar::set_bit(std::vector<std::uint64_t>& bits, int day) {
+        if (day < first_day_ || day > last_day_) return;
+        int offset = day - first_day_;
+        bits[offset / 64] |= 1ULL << (offset % 64);
+    }
+
+    void work_calendar::rebuild_holidays() {
+        holidays_.assign(word_count(), 0);
+
+        for (int year = first_year_; year <= last_year_; ++year) {
+            int easter = easter_sunday(year);
+
+            for (const auto& rule : GERMAN_HOLIDAYS) {
+                if (!(rule.states & state_bit(state_))) continue;
+                if (year < rule.since_year || year > rule.until_year) continue;
+
+                switch (rule.kind) {
+                case holiday_kind::fixed:
+                    set_bit(holidays_, time_utils::day_number(year, rule.month, rule.day));
+                    break;
+                case holiday_kind::easter:
+                    set_bit(holidays_, easter + rule.day);
+                    break;
+                case holiday_kind::repentance_day: {
+                    int november_22 = time_utils::day_number(year, 11, 22);
+                    set_bit(holidays_, november_22 - (weekday(november_22) - 2 + 7) % 7);
+                    break;
+                }
+                }
+            }
+        }
+
+        for (int day : custom_holidays_) {
+            set_bit(holidays_, day);
+        }
+    }
+
+    void work_calendar::rebuild_working_days() {
+        target_minutes_.clear();
+        working_days_.clear();
+
+        for (int weekday_index = 0; weekday_index < 7; ++weekday_index) {
+            auto target = weekday_minutes_[weekday_index];
+            if (target.count() <= 0) continue;
+
+            auto it = std::find(target_minutes_.begin(), target_minutes_.end(), target);
+            size_t group = static_cast<size_t>(it - target_minutes_.begin());
+            if (it == target_minutes_.end()) {
+                target_minutes_.push_back(target);
+                working_days_.emplace_back(word_count(), 0);
+            }
+
+            // first calendar day falling on this weekday, then every 7th day
+            int day = first_day_ + (weekday_index - weekday(first_day_) + 7) % 7;
+            for (; day <= last_day_; day += 7) {
+                set_bit(working_days_[group], day);
+            }
+        }
+
+        for (auto& bits : working_days_) {
+            for (size_t i = 0; i < bits.size(); ++i) {
+                bits[i] &= ~(holidays_[i] | absences_[i]);
+            }
+        }
+    }
+
+    bool work_calendar::load(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) return false;
+
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream ss(line);
+            std::string key;
+            ss >> key;
+            if (key.empty() || key[0] == '#') continue;
+
+            if (key == "state") {
+                std::string code;
+                ss >> code;
+                std::transform(code.begin(), code.end(), code.begin(),
+                    [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+                for (int i = 1; i < 17; ++i) {
+                    if (code == STATE_CODES[i]) {
+                        state_ = static_cast<german_state>(i);
+                    }
+                }
+            }
+            else if (key == "hours") {
+                std::string name;
+                double hours = 0.0;
+                ss >> name >> hours;
+                if (ss.fail()) continue;
+                for (int i = 0; i < 7; ++i) {
+                    if (name == WEEKDAY_NAMES[i]) {
+                        weekday_minutes_[i] = std::chrono::minutes(static_cast<int>(hours * 60 + 0.5));
+                    }
+                }
+            }
+            else if (key == "holiday") {
+                std::string date;
+                int day = 0;
+                ss >> date;
+                if (parse_date(date, day)) {
+                    custom_holidays_.push_back(day);
+                }
+            }
+            else if (key == "absence") {
+                std::string from, to;
+                int first = 0, last = 0;
+                ss >> from >> to;
+                if (!parse_date(from, first)) continue;
+                if (to.empty() || !parse_date(to, last)) last = first;
+                for (int day = std::max(first, first_day_); day <= std::min(last, last_day_); ++day) {
+                    set_bit(absences_, day);
+                }
+            }
+        }
+
+        rebuild_holidays();
+        rebuild_working_days();
+        return true;
+    }
+
+    bool work_calendar::is_working_day(int day) const {
+        return expected_on(day).count() > 0;
+    }
+
+    std::chrono::minutes work_calendar::expected_on(int day) const {
+        return expected_between(day, day);
+    }
+
+    std::chrono::minutes work_calendar::expected_between(int first_day, int last_day) const {
+        int first = std::max(first_day, first_day_) - first_day_;
+        int last = std::min(last_day, last_day_) - first_day_;
+        if (first > last) return std::chrono::minutes(0);
+
+        size_t first_word = static_cast<size_t>(first) / 64;
+        size_t last_word = static_cast<size_t>(last) / 64;
+
+        std::chrono::minutes total{ 0 };
+        for (size_t group = 0; group < working_days_.size(); ++group) {
+            const auto& bits = working_days_[group];
+            long long days = 0;
+
+            if (first_word == last_word) {
+                days = popcount(bits[first_word] & range_mask(first_word, first, last));
+            }
+            else {
+                days += popcount(bits[first_word] & range_mask(first_word, first, last));
+                for (size_t i = first_word + 1; i < last_word; ++i) {
+                    days += popcount(bits[i]);
+                }
+                days += popcount(bits[last_word] & range_mask(last_word, first, last));
+            }
+
+            total += target_minutes_[group] * days;
+        }
+        return total;
+    }
+
+    overtime_balance compute_overtime_balance(const work_calendar& calendar, const std::string& weekly_log_path) {
+        overtime_balance result;
+        bool any = false;
+
+        // lines look like "YYYY-MM-DD - 7h 45m"
+        std::ifstream file(weekly_log_path);
+        std::string line;
+        while (std::getline(file, line)) {
+            int day = 0;
+            std::chrono::minutes worked{ 0 };
+            if (!time_utils::parse_weekly_line(line.data(), line.size(), day, worked)) continue;
+
+            result.worked += worked;
+            if (!any || day < result.first_day) result.first_day = day;
+            if (!any || day > result.last_day) result.last_day = day;
+            any = true;
+        }
+
+        if (any) {
+            result.expected = calendar.expected_between(result.first_day, result.last_day);
+        }
+        return result;
+    }
+}
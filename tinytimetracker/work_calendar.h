@@ -0,0 +1,73 @@
+#pragma once
+#include "types.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace time_tracker {
+    // german federal states with their own public holidays
+    enum class german_state {
+        none,
+        bw, by, be, bb, hb, hh, he, mv, ni, nw, rp, sl, sn, st, sh, th
+    };
+
+    // working days, holidays and absences as packed day bitmaps (one bit per day
+    // since 1970-01-01) so expected hours between two dates is a popcount over words
+    class work_calendar {
+    private:
+        int first_year_;
+        int last_year_;
+        int first_day_;
+        int last_day_;
+
+        std::array<std::chrono::minutes, 7> weekday_minutes_;  // monday first
+        german_state state_{ german_state::none };
+        std::vector<int> custom_holidays_;
+
+        std::vector<std::uint64_t> holidays_;
+        std::vector<std::uint64_t> absences_;
+
+        // one bitmap per distinct daily target: working days with that target
+        // that are neither holidays nor absences
+        std::vector<std::chrono::minutes> target_minutes_;
+        std::vector<std::vector<std::uint64_t>> working_days_;
+
+        size_t word_count() const;
+        void set_bit(std::vector<std::uint64_t>& bits, int day);
+        void rebuild_holidays();
+        void rebuild_working_days();
+
+    public:
+        work_calendar(int first_year, int last_year);
+
+        // day numbers count days since 1970-01-01, see time_utils::day_number
+        static int today();
+        static int weekday(int day);  // 0 = monday
+        static bool parse_date(const std::string& text, int& day);  // "YYYY-MM-DD"
+
+        // read "state", "hours", "holiday" and "absence" lines, see calendar.txt in the readme.
+        // the only way to configure a calendar, unloaded it has 8-hour weekdays and the
+        // nationwide holidays
+        bool load(const std::string& path);
+
+        bool is_working_day(int day) const;
+        std::chrono::minutes expected_on(int day) const;
+
+        // expected work time for the inclusive day range, days outside the calendar count as free
+        std::chrono::minutes expected_between(int first_day, int last_day) const;
+    };
+
+    struct overtime_balance {
+        int first_day{ 0 };
+        int last_day{ -1 };
+        std::chrono::minutes worked{ 0 };
+        std::chrono::minutes expected{ 0 };
+
+        std::chrono::minutes balance() const { return worked - expected; }
+    };
+
+    // net work time logged in weekly_hours.txt against the calendar, from the first
+    // to the last logged day
+    overtime_balance compute_overtime_balance(const work_calendar& calendar, const std::string& weekly_log_path);
+}